@@ -1,6 +1,9 @@
 package v8go
 
-import "time"
+import (
+	"time"
+	"unsafe"
+)
 
 // Backport time.UnixMicro from go 1.17 - https://pkg.go.dev/time#UnixMicro
 // timeUnixMicro accepts microseconds and converts to nanoseconds to be used
@@ -9,3 +12,19 @@ import "time"
 func timeUnixMicro(usec int64) time.Time {
 	return time.Unix(0, usec*1000)
 }
+
+// Backport unsafe.StringData from go 1.20 - https://pkg.go.dev/unsafe#StringData
+// stringData returns a pointer to the bytes of s, which must not be modified.
+// For an empty string, the result is unspecified and may be nil.
+func stringData(s string) *byte {
+	// The data pointer is the first word of a string header.
+	return *(**byte)(unsafe.Pointer(&s))
+}
+
+// Backport unsafe.String from go 1.20 - https://pkg.go.dev/unsafe#String
+// bytesString returns a string sharing the bytes of b, which must not be
+// modified afterwards.
+func bytesString(b []byte) string {
+	// A string header is a prefix of a slice header.
+	return *(*string)(unsafe.Pointer(&b))
+}
@@ -0,0 +1,167 @@
+#include "batch.h"
+
+#include <vector>
+
+#include "context-macros.h"
+#include "deps/include/v8-container.h"
+#include "deps/include/v8-function.h"
+#include "deps/include/v8-object.h"
+#include "deps/include/v8-primitive.h"
+#include "value.h"
+
+using namespace v8;
+
+/********** Batch **********/
+
+// runBatch executes ops, collecting the values marked with BATCH_OP_RESULT.
+// It returns false if a JavaScript exception is pending.
+static bool runBatch(Isolate* iso,
+                     Local<Context> local_ctx,
+                     const uint32_t* ops,
+                     int ops_len,
+                     const char* strings,
+                     ValuePtr* inputs,
+                     std::vector<Local<Value>>& results) {
+  std::vector<Local<Value>> regs;
+  std::vector<Local<Value>> args;
+
+  for (int pc = 0; pc < ops_len;) {
+    const uint32_t* op = ops + pc;
+    switch (op[0]) {
+      case BATCH_OP_INPUT:
+        regs.push_back(inputs[op[1]]->ptr.Get(iso));
+        pc += 2;
+        break;
+
+      case BATCH_OP_STRING: {
+        Local<String> str;
+        if (!String::NewFromUtf8(iso, strings + op[1], NewStringType::kNormal,
+                                 op[2])
+                 .ToLocal(&str)) {
+          return false;
+        }
+        regs.push_back(str);
+        pc += 3;
+        break;
+      }
+
+      case BATCH_OP_GET: {
+        Local<Object> obj;
+        Local<String> key;
+        Local<Value> result;
+        if (!regs[op[1]]->ToObject(local_ctx).ToLocal(&obj) ||
+            !String::NewFromUtf8(iso, strings + op[2],
+                                 NewStringType::kInternalized, op[3])
+                 .ToLocal(&key) ||
+            !obj->Get(local_ctx, key).ToLocal(&result)) {
+          return false;
+        }
+        regs.push_back(result);
+        pc += 4;
+        break;
+      }
+
+      case BATCH_OP_GET_IDX: {
+        Local<Object> obj;
+        Local<Value> result;
+        if (!regs[op[1]]->ToObject(local_ctx).ToLocal(&obj) ||
+            !obj->Get(local_ctx, op[2]).ToLocal(&result)) {
+          return false;
+        }
+        regs.push_back(result);
+        pc += 3;
+        break;
+      }
+
+      case BATCH_OP_SET: {
+        Local<Object> obj;
+        Local<String> key;
+        if (!regs[op[1]]->ToObject(local_ctx).ToLocal(&obj) ||
+            !String::NewFromUtf8(iso, strings + op[2],
+                                 NewStringType::kInternalized, op[3])
+                 .ToLocal(&key) ||
+            obj->Set(local_ctx, key, regs[op[4]]).IsNothing()) {
+          return false;
+        }
+        pc += 5;
+        break;
+      }
+
+      case BATCH_OP_SET_IDX: {
+        Local<Object> obj;
+        if (!regs[op[1]]->ToObject(local_ctx).ToLocal(&obj) ||
+            obj->Set(local_ctx, op[2], regs[op[3]]).IsNothing()) {
+          return false;
+        }
+        pc += 4;
+        break;
+      }
+
+      case BATCH_OP_CALL: {
+        Local<Value> fn = regs[op[1]];
+        if (!fn->IsFunction()) {
+          iso->ThrowException(Exception::TypeError(
+              String::NewFromUtf8Literal(iso, "value is not a function")));
+          return false;
+        }
+        uint32_t argc = op[3];
+        args.clear();
+        for (uint32_t i = 0; i < argc; ++i) {
+          args.push_back(regs[op[4 + i]]);
+        }
+        Local<Value> result;
+        if (!fn.As<Function>()
+                 ->Call(local_ctx, regs[op[2]], argc, args.data())
+                 .ToLocal(&result)) {
+          return false;
+        }
+        regs.push_back(result);
+        pc += 4 + argc;
+        break;
+      }
+
+      case BATCH_OP_NEW_OBJECT:
+        regs.push_back(Object::New(iso));
+        pc += 1;
+        break;
+
+      case BATCH_OP_NEW_ARRAY:
+        regs.push_back(Array::New(iso, op[1]));
+        pc += 2;
+        break;
+
+      case BATCH_OP_RESULT:
+        results.push_back(regs[op[1]]);
+        pc += 2;
+        break;
+
+      default:
+        iso->ThrowException(Exception::Error(
+            String::NewFromUtf8Literal(iso, "invalid batch operation")));
+        return false;
+    }
+  }
+  return true;
+}
+
+RtnError ContextRunBatch(ContextPtr ctx,
+                         const uint32_t* ops,
+                         int ops_len,
+                         const char* strings,
+                         ValuePtr* inputs,
+                         ValuePtr* results) {
+  LOCAL_CONTEXT(ctx);
+  RtnError rtn = {};
+
+  std::vector<Local<Value>> locals;
+  if (!runBatch(iso, local_ctx, ops, ops_len, strings, inputs, locals)) {
+    rtn = ExceptionError(try_catch, iso, local_ctx);
+    return rtn;
+  }
+  // Results are only tracked once the whole batch has succeeded, so a failed
+  // batch doesn't leave values behind.
+  for (size_t i = 0; i < locals.size(); ++i) {
+    results[i] = tracked_value(ctx, locals[i]);
+  }
+  return rtn;
+}
@@ -0,0 +1,183 @@
+package v8go
+
+// #include "batch.h"
+// #include "context.h"
+import "C"
+import (
+	"fmt"
+	"runtime"
+	"unsafe"
+)
+
+// BatchReg refers to a value produced by an operation of a Batch.
+type BatchReg uint32
+
+// Batch records a sequence of property reads and writes, function calls and
+// object creations, which Context.RunBatch then executes with a single call
+// into V8. Operations that produce a value return a BatchReg that later
+// operations can use; only values marked with Result are returned to Go.
+//
+// A Batch is not safe for concurrent use, but can be run any number of times,
+// in any context of the isolate its inputs belong to.
+type Batch struct {
+	ops     []uint32
+	strings []byte
+	// inputs keeps the input values alive, so values released once Go
+	// has collected them (see WithAutoRelease) stay valid while the batch
+	// exists.
+	inputs   []*Value
+	nregs    uint32
+	nresults int
+}
+
+// NewBatch creates an empty batch.
+func NewBatch() *Batch {
+	return &Batch{}
+}
+
+// Reset removes all operations, so the batch can be reused.
+func (b *Batch) Reset() {
+	b.ops = b.ops[:0]
+	b.strings = b.strings[:0]
+	for i := range b.inputs {
+		b.inputs[i] = nil
+	}
+	b.inputs = b.inputs[:0]
+	b.nregs = 0
+	b.nresults = 0
+}
+
+// Input makes an existing value available to the batch.
+func (b *Batch) Input(v Valuer) BatchReg {
+	b.ops = append(b.ops, C.BATCH_OP_INPUT, uint32(len(b.inputs)))
+	b.inputs = append(b.inputs, v.value())
+	return b.newReg()
+}
+
+// String creates a string value.
+func (b *Batch) String(s string) BatchReg {
+	off, n := b.addString(s)
+	b.ops = append(b.ops, C.BATCH_OP_STRING, off, n)
+	return b.newReg()
+}
+
+// Get reads the property key of obj, like `obj[key]` in JS.
+func (b *Batch) Get(obj BatchReg, key string) BatchReg {
+	b.checkReg(obj)
+	off, n := b.addString(key)
+	b.ops = append(b.ops, C.BATCH_OP_GET, uint32(obj), off, n)
+	return b.newReg()
+}
+
+// GetIdx reads the element idx of obj, like `obj[idx]` in JS.
+func (b *Batch) GetIdx(obj BatchReg, idx uint32) BatchReg {
+	b.checkReg(obj)
+	b.ops = append(b.ops, C.BATCH_OP_GET_IDX, uint32(obj), idx)
+	return b.newReg()
+}
+
+// Set sets the property key of obj to val, like `obj[key] = val` in JS.
+func (b *Batch) Set(obj BatchReg, key string, val BatchReg) {
+	b.checkReg(obj)
+	b.checkReg(val)
+	off, n := b.addString(key)
+	b.ops = append(b.ops, C.BATCH_OP_SET, uint32(obj), off, n, uint32(val))
+}
+
+// SetIdx sets the element idx of obj to val, like `obj[idx] = val` in JS.
+func (b *Batch) SetIdx(obj BatchReg, idx uint32, val BatchReg) {
+	b.checkReg(obj)
+	b.checkReg(val)
+	b.ops = append(b.ops, C.BATCH_OP_SET_IDX, uint32(obj), idx, uint32(val))
+}
+
+// Call calls the function fn with recv as `this`.
+func (b *Batch) Call(fn, recv BatchReg, args ...BatchReg) BatchReg {
+	b.checkReg(fn)
+	b.checkReg(recv)
+	b.ops = append(b.ops, C.BATCH_OP_CALL, uint32(fn), uint32(recv), uint32(len(args)))
+	for _, arg := range args {
+		b.checkReg(arg)
+		b.ops = append(b.ops, uint32(arg))
+	}
+	return b.newReg()
+}
+
+// NewObject creates an empty object, like `{}` in JS.
+func (b *Batch) NewObject() BatchReg {
+	b.ops = append(b.ops, C.BATCH_OP_NEW_OBJECT)
+	return b.newReg()
+}
+
+// NewArray creates an array with the given length.
+func (b *Batch) NewArray(length uint32) BatchReg {
+	b.ops = append(b.ops, C.BATCH_OP_NEW_ARRAY, length)
+	return b.newReg()
+}
+
+// Result marks r to be returned by Context.RunBatch. Results are returned in
+// the order they were marked.
+func (b *Batch) Result(r BatchReg) {
+	b.checkReg(r)
+	b.ops = append(b.ops, C.BATCH_OP_RESULT, uint32(r))
+	b.nresults++
+}
+
+func (b *Batch) newReg() BatchReg {
+	b.nregs++
+	return BatchReg(b.nregs - 1)
+}
+
+func (b *Batch) checkReg(r BatchReg) {
+	if uint32(r) >= b.nregs {
+		panic(fmt.Sprintf("v8go: batch register %d out of range", r))
+	}
+}
+
+func (b *Batch) addString(s string) (off, n uint32) {
+	off = uint32(len(b.strings))
+	b.strings = append(b.strings, s...)
+	return off, uint32(len(s))
+}
+
+// RunBatch executes all operations of b in the context, and returns the values
+// marked with Batch.Result. If an operation throws, the remaining operations
+// are skipped, no values are returned, and the error will be of type `JSError`.
+// Inputs must belong to the context or its isolate.
+func (c *Context) RunBatch(b *Batch) ([]*Value, error) {
+	if len(b.ops) == 0 {
+		return nil, nil
+	}
+	var strings *C.char
+	if len(b.strings) > 0 {
+		strings = (*C.char)(unsafe.Pointer(&b.strings[0]))
+	}
+	var inputs *C.ValuePtr
+	if len(b.inputs) > 0 {
+		ptrs := make([]C.ValuePtr, len(b.inputs))
+		for i, v := range b.inputs {
+			ptrs[i] = v.ptr
+		}
+		inputs = &ptrs[0]
+	}
+	results := make([]C.ValuePtr, b.nresults)
+	var resultsPtr *C.ValuePtr
+	if len(results) > 0 {
+		resultsPtr = &results[0]
+	}
+
+	rtnErr := C.ContextRunBatch(c.ptr, (*C.uint32_t)(unsafe.Pointer(&b.ops[0])), C.int(len(b.ops)), strings, inputs, resultsPtr)
+	runtime.KeepAlive(b)
+	// Queued values are only released after the call, which reads the inputs
+	// through their pointers.
+	c.releaseQueued()
+	if rtnErr.msg != nil {
+		return nil, newJSError(rtnErr)
+	}
+
+	vals := make([]*Value, len(results))
+	for i, ptr := range results {
+		vals[i] = newValue(ptr, c)
+	}
+	return vals, nil
+}
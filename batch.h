@@ -0,0 +1,42 @@
+#ifndef V8GO_BATCH_H
+#define V8GO_BATCH_H
+
+#include <stdint.h>
+
+#include "errors.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct m_ctx m_ctx;
+typedef m_ctx* ContextPtr;
+
+// Batch operations. Each is a word followed by its operands. Operations that
+// produce a value append it to the register file, so registers are numbered in
+// the order they were produced. Strings are (offset, length) pairs into the
+// batch's string buffer.
+typedef enum {
+  BATCH_OP_INPUT = 1,   // input index
+  BATCH_OP_STRING,      // string offset, string length
+  BATCH_OP_GET,         // object, key offset, key length
+  BATCH_OP_GET_IDX,     // object, index
+  BATCH_OP_SET,         // object, key offset, key length, value
+  BATCH_OP_SET_IDX,     // object, index, value
+  BATCH_OP_CALL,        // function, receiver, argc, args...
+  BATCH_OP_NEW_OBJECT,  //
+  BATCH_OP_NEW_ARRAY,   // length
+  BATCH_OP_RESULT,      // register
+} BatchOp;
+
+extern RtnError ContextRunBatch(ContextPtr ctx,
+                                const uint32_t* ops,
+                                int ops_len,
+                                const char* strings,
+                                ValuePtr* inputs,
+                                ValuePtr* results);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
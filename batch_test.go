@@ -0,0 +1,91 @@
+package v8go_test
+
+import (
+	"runtime"
+	"testing"
+
+	v8 "github.com/tommie/v8go"
+)
+
+func TestContextRunBatch(t *testing.T) {
+	t.Parallel()
+
+	ctx := v8.NewContext()
+	defer ctx.Isolate().Dispose()
+	defer ctx.Close()
+
+	src, err := ctx.RunScript(`({
+		name: "v8go",
+		tags: ["a", "b"],
+		greet(who) { return this.name + " greets " + who; },
+	})`, "")
+	fatalIf(t, err)
+
+	b := v8.NewBatch()
+	in := b.Input(src)
+	name := b.Get(in, "name")
+	tag := b.GetIdx(b.Get(in, "tags"), 1)
+	greeting := b.Call(b.Get(in, "greet"), in, b.String("you"))
+
+	out := b.NewObject()
+	b.Set(out, "title", name)
+	list := b.NewArray(2)
+	b.SetIdx(list, 0, tag)
+	b.SetIdx(list, 1, greeting)
+	b.Set(out, "list", list)
+	b.Result(name)
+	b.Result(out)
+
+	vals, err := ctx.RunBatch(b)
+	fatalIf(t, err)
+	if len(vals) != 2 {
+		t.Fatalf("expected 2 results, got %d", len(vals))
+	}
+	if s := vals[0].String(); s != "v8go" {
+		t.Errorf("expected name to be v8go, got %q", s)
+	}
+	js, err := v8.JSONStringify(ctx, vals[1])
+	fatalIf(t, err)
+	if want := `{"title":"v8go","list":["b","v8go greets you"]}`; js != want {
+		t.Errorf("expected %s, got %s", want, js)
+	}
+
+	// A batch can be reset and reused.
+	b.Reset()
+	b.Call(b.Get(b.Input(src), "name"), b.NewObject())
+	if _, err := ctx.RunBatch(b); err == nil {
+		t.Error("expected calling a non-function to fail")
+	} else if _, ok := err.(*v8.JSError); !ok {
+		t.Errorf("expected a JSError, got %T", err)
+	}
+
+	if recoverPanic(func() { b.Result(v8.BatchReg(100)) }) == nil {
+		t.Error("expected panic on an out of range register")
+	}
+}
+
+func TestContextRunBatchAutoRelease(t *testing.T) {
+	t.Parallel()
+
+	iso := v8.NewIsolate(v8.WithAutoRelease())
+	defer iso.Dispose()
+	ctx := v8.NewContext(iso)
+	defer ctx.Close()
+
+	b := v8.NewBatch()
+	func() {
+		src, err := ctx.RunScript(`({ name: "v8go" })`, "")
+		fatalIf(t, err)
+		b.Result(b.Get(b.Input(src), "name"))
+	}()
+
+	// The batch keeps its input alive after the caller dropped it.
+	for i := 0; i < 3; i++ {
+		runtime.GC()
+		vals, err := ctx.RunBatch(b)
+		fatalIf(t, err)
+		if s := vals[0].String(); s != "v8go" {
+			t.Errorf("expected name to be v8go, got %q", s)
+		}
+	}
+}
@@ -0,0 +1,158 @@
+package v8go
+
+// #include "unbound_script.h"
+import "C"
+import (
+	"bytes"
+	"crypto/sha256"
+	"encoding/binary"
+	"encoding/hex"
+	"errors"
+	"fmt"
+	"os"
+	"path/filepath"
+	"syscall"
+	"unsafe"
+)
+
+// codeCacheMagic starts every code cache file. The header continues with the
+// hash of the V8 flags, the length of the V8 version and the version itself,
+// padded so the code cache is 8-byte aligned and V8 can use it in place.
+const codeCacheMagic = "v8gocc01"
+
+// CodeCache is a directory of V8 code caches, one file per script source, so
+// that scripts compiled by an earlier run of the process can be deserialized
+// instead of compiled. Files are memory-mapped while V8 reads them, and are
+// only used if they were created by the same V8 version with the same flags
+// (see SetFlags). Stale files are removed when they are found.
+//
+// A CodeCache is safe for concurrent use, also by several processes sharing
+// the directory.
+type CodeCache struct {
+	dir string
+}
+
+// NewCodeCache returns a code cache stored in dir, which is created if it
+// doesn't exist.
+func NewCodeCache(dir string) (*CodeCache, error) {
+	if err := os.MkdirAll(dir, 0o755); err != nil {
+		return nil, err
+	}
+	return &CodeCache{dir: dir}, nil
+}
+
+// CompileUnboundScript is like Isolate.CompileUnboundScript, but uses the code
+// cache stored for the source if there is a valid one, and stores one
+// otherwise. The returned bool reports whether a stored code cache was used.
+// If only storing the code cache fails, the script is returned along with the
+// error.
+func (c *CodeCache) CompileUnboundScript(iso *Isolate, source, origin string) (*UnboundScript, bool, error) {
+	sum := sha256.Sum256([]byte(source))
+	path := filepath.Join(c.dir, hex.EncodeToString(sum[:]))
+
+	if data, unmap := c.load(iso, path); data != nil {
+		cached := &CompilerCachedData{Bytes: data}
+		us, err := iso.CompileUnboundScript(source, origin, CompileOptions{CachedData: cached})
+		unmap()
+		if err != nil {
+			return nil, false, err
+		}
+		if !cached.Rejected {
+			return us, true, nil
+		}
+		// V8 compiled the script from source, so the cache can be replaced.
+		return us, false, c.store(path, us)
+	}
+
+	us, err := iso.CompileUnboundScript(source, origin, CompileOptions{})
+	if err != nil {
+		return nil, false, err
+	}
+	return us, false, c.store(path, us)
+}
+
+// load maps the code cache in path, if it exists and is compatible with the
+// isolate. Incompatible files are removed.
+func (c *CodeCache) load(iso *Isolate, path string) ([]byte, func()) {
+	f, err := os.Open(path)
+	if err != nil {
+		return nil, nil
+	}
+	defer f.Close()
+	fi, err := f.Stat()
+	if err != nil || fi.Size() == 0 {
+		return nil, nil
+	}
+	mapped, err := syscall.Mmap(int(f.Fd()), 0, int(fi.Size()), syscall.PROT_READ, syscall.MAP_SHARED)
+	if err != nil {
+		return nil, nil
+	}
+	unmap := func() { syscall.Munmap(mapped) }
+
+	data, ok := parseCodeCacheHeader(mapped)
+	if ok {
+		ok = len(data) > 0 && C.ScriptCompilerCachedDataCheck(iso.ptr, (*C.uint8_t)(unsafe.Pointer(&data[0])), C.int(len(data))) == 0
+	}
+	if !ok {
+		unmap()
+		os.Remove(path)
+		return nil, nil
+	}
+	return data, unmap
+}
+
+// parseCodeCacheHeader returns the V8 code cache following the header, if the
+// header matches the running V8.
+func parseCodeCacheHeader(b []byte) ([]byte, bool) {
+	version := Version()
+	n := len(codeCacheMagic) + 8 + 2
+	if len(b) < n || string(b[:len(codeCacheMagic)]) != codeCacheMagic {
+		return nil, false
+	}
+	flags := binary.LittleEndian.Uint64(b[len(codeCacheMagic):])
+	versionLen := int(binary.LittleEndian.Uint16(b[n-2:]))
+	end := alignCodeCacheHeader(n + versionLen)
+	if flags != currentFlagsHash() || len(b) < end || string(b[n:n+versionLen]) != version {
+		return nil, false
+	}
+	return b[end:], true
+}
+
+func alignCodeCacheHeader(n int) int {
+	return (n + 7) &^ 7
+}
+
+// store writes the code cache of us to path. It writes a temporary file first,
+// so readers never see a partial file.
+func (c *CodeCache) store(path string, us *UnboundScript) error {
+	cached := us.CreateCodeCache()
+	if len(cached.Bytes) == 0 {
+		return errors.New("v8go: V8 created an empty code cache")
+	}
+	version := Version()
+
+	var buf bytes.Buffer
+	buf.WriteString(codeCacheMagic)
+	binary.Write(&buf, binary.LittleEndian, currentFlagsHash())
+	binary.Write(&buf, binary.LittleEndian, uint16(len(version)))
+	buf.WriteString(version)
+	buf.Write(make([]byte, alignCodeCacheHeader(buf.Len())-buf.Len()))
+	buf.Write(cached.Bytes)
+
+	f, err := os.CreateTemp(c.dir, ".tmp-*")
+	if err != nil {
+		return err
+	}
+	_, err = f.Write(buf.Bytes())
+	if cerr := f.Close(); err == nil {
+		err = cerr
+	}
+	if err == nil {
+		err = os.Rename(f.Name(), path)
+	}
+	if err != nil {
+		os.Remove(f.Name())
+		return fmt.Errorf("v8go: storing code cache: %w", err)
+	}
+	return nil
+}
@@ -0,0 +1,59 @@
+package v8go_test
+
+import (
+	"os"
+	"path/filepath"
+	"testing"
+
+	v8 "github.com/tommie/v8go"
+)
+
+func TestCodeCache(t *testing.T) {
+	t.Parallel()
+
+	dir := t.TempDir()
+	cache, err := v8.NewCodeCache(dir)
+	fatalIf(t, err)
+	const source = `function add(a, b) { return a + b }; add(40, 2)`
+
+	compile := func(wantUsed bool) {
+		t.Helper()
+		iso := v8.NewIsolate()
+		defer iso.Dispose()
+		us, used, err := cache.CompileUnboundScript(iso, source, "add.js")
+		fatalIf(t, err)
+		if used != wantUsed {
+			t.Errorf("expected code cache used to be %v, got %v", wantUsed, used)
+		}
+		ctx := v8.NewContext(iso)
+		defer ctx.Close()
+		val, err := us.Run(ctx)
+		fatalIf(t, err)
+		if val.Int32() != 42 {
+			t.Errorf("expected 42, got %v", val)
+		}
+	}
+
+	compile(false)
+	compile(true)
+
+	files, err := filepath.Glob(filepath.Join(dir, "*"))
+	fatalIf(t, err)
+	if len(files) != 1 {
+		t.Fatalf("expected one cache file, got %v", files)
+	}
+
+	// A file from another V8 version is dropped and replaced.
+	b, err := os.ReadFile(files[0])
+	fatalIf(t, err)
+	copy(b[len("v8gocc01")+8+2:], "0.0")
+	fatalIf(t, os.WriteFile(files[0], b, 0o644))
+	compile(false)
+	compile(true)
+
+	iso := v8.NewIsolate()
+	defer iso.Dispose()
+	if _, _, err := cache.CompileUnboundScript(iso, `(`, "broken.js"); err == nil {
+		t.Error("expected a syntax error")
+	}
+}
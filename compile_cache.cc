@@ -0,0 +1,87 @@
+#include "compile_cache.h"
+
+#include <functional>
+
+#include "context.h"
+#include "deps/include/v8-script.h"
+#include "isolate-macros.h"
+
+using namespace v8;
+
+/********** CompileCache **********/
+
+size_t m_compileCache::hash(std::string_view source, std::string_view origin) {
+  size_t h = std::hash<std::string_view>{}(source);
+  return h ^ (std::hash<std::string_view>{}(origin) + 0x9e3779b97f4a7c15ULL +
+              (h << 6) + (h >> 2));
+}
+
+MaybeLocal<UnboundScript> m_compileCache::Lookup(Isolate* iso,
+                                                 std::string_view source,
+                                                 std::string_view origin) {
+  auto found = index_.find(hash(source, origin));
+  if (found == index_.end() || found->second->source != source ||
+      found->second->origin != origin) {
+    ++misses;
+    return MaybeLocal<UnboundScript>();
+  }
+  ++hits;
+  lru_.splice(lru_.begin(), lru_, found->second);
+  return found->second->script.Get(iso);
+}
+
+void m_compileCache::Insert(Isolate* iso,
+                            std::string_view source,
+                            std::string_view origin,
+                            Local<UnboundScript> script) {
+  size_t size = source.size() + origin.size();
+  if (max_bytes_ > 0 && size > max_bytes_) {
+    return;
+  }
+
+  size_t h = hash(source, origin);
+  // A colliding entry is replaced rather than chained.
+  auto found = index_.find(h);
+  if (found != index_.end()) {
+    erase(found->second);
+  }
+
+  lru_.push_front(entry{h, std::string(source), std::string(origin),
+                        Global<UnboundScript>(iso, script)});
+  index_[h] = lru_.begin();
+  bytes += size;
+
+  while (lru_.size() > max_entries_ || (max_bytes_ > 0 && bytes > max_bytes_)) {
+    erase(std::prev(lru_.end()));
+    ++evictions;
+  }
+}
+
+void m_compileCache::erase(std::list<entry>::iterator it) {
+  bytes -= it->source.size() + it->origin.size();
+  index_.erase(it->hash);
+  lru_.erase(it);
+}
+
+void IsolateEnableCompileCache(IsolatePtr iso,
+                               size_t max_entries,
+                               size_t max_bytes) {
+  ISOLATE_SCOPE(iso);
+  INTERNAL_CONTEXT(iso);
+  delete ctx->compileCache;
+  ctx->compileCache = new m_compileCache(max_entries, max_bytes);
+}
+
+CompileCacheStats IsolateGetCompileCacheStats(IsolatePtr iso) {
+  Locker locker(iso);
+  INTERNAL_CONTEXT(iso);
+  CompileCacheStats stats = {};
+  if (m_compileCache* cache = ctx->compileCache) {
+    stats.hits = cache->hits;
+    stats.misses = cache->misses;
+    stats.evictions = cache->evictions;
+    stats.entries = cache->entries();
+    stats.bytes = cache->bytes;
+  }
+  return stats;
+}
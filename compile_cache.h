@@ -0,0 +1,89 @@
+#ifndef V8GO_COMPILE_CACHE_H
+#define V8GO_COMPILE_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "deps/include/v8-local-handle.h"
+#include "deps/include/v8-persistent-handle.h"
+
+namespace v8 {
+class Isolate;
+class UnboundScript;
+}  // namespace v8
+typedef v8::Isolate v8Isolate;
+
+// m_compileCache maps script sources and origins to their compiled scripts,
+// evicting the least recently used ones beyond a number of entries or bytes of
+// source. It is owned by the isolate's internal context, and only used with
+// the isolate locked.
+class m_compileCache {
+ public:
+  m_compileCache(size_t max_entries, size_t max_bytes)
+      : max_entries_(max_entries), max_bytes_(max_bytes) {}
+
+  // Lookup returns the script compiled from source and origin, or an empty
+  // handle.
+  v8::MaybeLocal<v8::UnboundScript> Lookup(v8::Isolate* iso,
+                                           std::string_view source,
+                                           std::string_view origin);
+  void Insert(v8::Isolate* iso,
+              std::string_view source,
+              std::string_view origin,
+              v8::Local<v8::UnboundScript> script);
+
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+  uint64_t evictions = 0;
+  size_t bytes = 0;
+
+  size_t entries() const { return lru_.size(); }
+
+ private:
+  struct entry {
+    size_t hash;
+    std::string source;
+    std::string origin;
+    v8::Global<v8::UnboundScript> script;
+  };
+
+  static size_t hash(std::string_view source, std::string_view origin);
+  void erase(std::list<entry>::iterator it);
+
+  size_t max_entries_;
+  size_t max_bytes_;
+  // Most recently used first.
+  std::list<entry> lru_;
+  std::unordered_map<size_t, std::list<entry>::iterator> index_;
+};
+
+extern "C" {
+#else
+typedef struct v8Isolate v8Isolate;
+#endif
+typedef v8Isolate* IsolatePtr;
+
+typedef struct {
+  uint64_t hits;
+  uint64_t misses;
+  uint64_t evictions;
+  size_t entries;
+  size_t bytes;
+} CompileCacheStats;
+
+extern void IsolateEnableCompileCache(IsolatePtr iso_ptr,
+                                      size_t max_entries,
+                                      size_t max_bytes);
+extern CompileCacheStats IsolateGetCompileCacheStats(IsolatePtr iso_ptr);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
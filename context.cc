@@ -1,6 +1,8 @@
 #include "deps/include/v8-template.h"
 
 #include "context-macros.h"
+#include "isolate-macros.h"
+#include "script_source.h"
 #include "template.h"
 #include "unbound_script.h"
 #include "value.h"
@@ -21,17 +23,17 @@ ContextPtr NewContext(IsolatePtr iso,
     global_template = ObjectTemplate::New(iso);
   }
 
-  // For function callbacks we need a reference to the context, but because of
-  // the complexities of C -> Go function pointers, we store a reference to the
-  // context as a simple integer identifier; this can then be used on the Go
-  // side to lookup the context in the context registry. We use slot 1 as slot 0
-  // has special meaning for the Chrome debugger.
   Local<Context> local_ctx = Context::New(iso, nullptr, global_template);
-  local_ctx->SetEmbedderData(1, Integer::New(iso, ref));
 
-  m_ctx* ctx = new m_ctx;
+  m_ctx* ctx = new m_ctx{};
   ctx->ptr.Reset(iso, local_ctx);
   ctx->iso = iso;
+  ctx->ref = ref;
+
+  // Function callbacks find the m_ctx through the context's embedder data,
+  // and the Go Context through ref. We use slot 1 as slot 0 has special
+  // meaning for the Chrome debugger.
+  local_ctx->SetAlignedPointerInEmbedderData(1, ctx);
   return ctx;
 }
 
@@ -41,58 +43,118 @@ void ContextFree(ContextPtr ctx) {
   }
   ctx->ptr.Reset();
 
-  for (auto it = ctx->vals.begin(); it != ctx->vals.end(); ++it) {
-    auto value = it->second;
-    value->ptr.Reset();
-    delete value;
-  }
-  ctx->vals.clear();
+  // Only the handles need resetting here; the memory backing the values and
+  // scripts is owned by the context's slabs and released with it.
+  ctx->vals.ForEach([](m_value* val) { val->ptr.Reset(); });
 
   for (m_unboundScript* us : ctx->unboundScripts) {
     us->ptr.Reset();
-    delete us;
   }
 
+  for (m_callbackData* data : ctx->callbackData) {
+    data->handle.Reset();
+    delete data;
+  }
+
+  delete ctx->compileCache;
+
   delete ctx;
 }
 
-m_value* tracked_value(m_ctx* ctx, m_value* val) {
+m_value* tracked_value(m_ctx* ctx, Local<Value> local) {
   // (rogchap) we track values against a context so that when the context is
   // closed (either manually or GC'd by Go) we can also release all the
   // values associated with the context;
-  if (val->id == 0) {
-    val->id = ++ctx->nextValId;
-    ctx->vals[val->id] = val;
+  m_value* val = ctx->valueSlab.New();
+  val->header.kinds = value_kinds(local);
+  val->header.id = ctx->vals.Track(val);
+  val->iso = ctx->iso;
+  val->ctx = ctx;
+  val->ptr.Reset(ctx->iso, local);
+  val->scope = ctx->scopeMarks.size();
+  if (val->scope > 0) {
+    ctx->scopeVals.push_back(val->header.id);
   }
 
   return val;
 }
 
-ValuePtr ContextGlobal(ContextPtr ctx) {
-  LOCAL_CONTEXT(ctx);
-  m_value* val = new m_value;
-  val->id = 0;
+void release_value(m_value* val) {
+  m_ctx* ctx = val->ctx;
+  ctx->vals.Untrack(val->header.id);
+  ctx->valueSlab.Delete(val);
+}
 
-  val->iso = iso;
-  val->ctx = ctx;
-  val->ptr = Global<Value>(iso, local_ctx->Global());
+int ContextPushValueScope(ContextPtr ctx) {
+  Locker locker(ctx->iso);
+  ctx->scopeMarks.push_back(ctx->scopeVals.size());
+  return ctx->scopeMarks.size();
+}
 
-  return tracked_value(ctx, val);
+void ContextPopValueScope(ContextPtr ctx) {
+  Locker locker(ctx->iso);
+  if (ctx->scopeMarks.empty()) {
+    return;
+  }
+
+  int depth = ctx->scopeMarks.size();
+  size_t mark = ctx->scopeMarks.back();
+  ctx->scopeMarks.pop_back();
+
+  // Values escaped to an enclosing scope are compacted to the start of this
+  // scope's range, which then becomes part of the enclosing range.
+  size_t kept = mark;
+  for (size_t i = mark; i < ctx->scopeVals.size(); ++i) {
+    long id = ctx->scopeVals[i];
+    m_value* val = ctx->vals.Get(id);
+    if (val == nullptr) {
+      // Already released.
+      continue;
+    }
+    if (val->scope >= depth) {
+      release_value(val);
+    } else if (val->scope > 0) {
+      ctx->scopeVals[kept++] = id;
+    }
+  }
+  ctx->scopeVals.resize(kept);
 }
 
-int ContextRetainedValueCount(ContextPtr ctx) {
-  return ctx->vals.size();
+void ContextReleaseValueIds(ContextPtr ctx, long* ids, int len) {
+  Locker locker(ctx->iso);
+
+  for (int i = 0; i < len; ++i) {
+    // The id may be stale if the value was released some other way, e.g. by
+    // a value scope, after it was queued.
+    m_value* val = ctx->vals.Get(ids[i]);
+    if (val != nullptr) {
+      release_value(val);
+    }
+  }
 }
 
-RtnValue RunScript(ContextPtr ctx, const char* source, const char* origin) {
+ValuePtr ContextGlobal(ContextPtr ctx) {
   LOCAL_CONTEXT(ctx);
+  return tracked_value(ctx, local_ctx->Global());
+}
 
+int ContextRetainedValueCount(ContextPtr ctx) {
+  return ctx->vals.Count();
+}
+
+// runScript compiles and runs the source, which may be empty if creating it
+// failed.
+static RtnValue runScript(m_ctx* ctx,
+                          Isolate* iso,
+                          Local<Context> local_ctx,
+                          TryCatch& try_catch,
+                          MaybeLocal<String> maybeSrc,
+                          const char* origin,
+                          int origin_len) {
   RtnValue rtn = {};
 
-  MaybeLocal<String> maybeSrc =
-      String::NewFromUtf8(iso, source, NewStringType::kNormal);
   MaybeLocal<String> maybeOgn =
-      String::NewFromUtf8(iso, origin, NewStringType::kNormal);
+      String::NewFromUtf8(iso, origin, NewStringType::kNormal, origin_len);
   Local<String> src, ogn;
   if (!maybeSrc.ToLocal(&src) || !maybeOgn.ToLocal(&ogn)) {
     rtn.error = ExceptionError(try_catch, iso, local_ctx);
@@ -110,12 +172,75 @@ RtnValue RunScript(ContextPtr ctx, const char* source, const char* origin) {
     rtn.error = ExceptionError(try_catch, iso, local_ctx);
     return rtn;
   }
-  m_value* val = new m_value;
-  val->id = 0;
-  val->iso = iso;
-  val->ctx = ctx;
-  val->ptr = Global<Value>(iso, result);
+  rtn.value = tracked_value(ctx, result);
+  return rtn;
+}
 
-  rtn.value = tracked_value(ctx, val);
+// runCachedScript is like runScript, but looks up the compiled script in the
+// isolate's compile cache first, and adds it on a miss.
+static RtnValue runCachedScript(m_ctx* ctx,
+                                Isolate* iso,
+                                Local<Context> local_ctx,
+                                TryCatch& try_catch,
+                                m_compileCache* cache,
+                                std::string_view source,
+                                std::string_view origin) {
+  RtnValue rtn = {};
+
+  Local<UnboundScript> unbound_script;
+  if (!cache->Lookup(iso, source, origin).ToLocal(&unbound_script)) {
+    Local<String> src, ogn;
+    if (!String::NewFromUtf8(iso, source.data(), NewStringType::kNormal,
+                             source.size())
+             .ToLocal(&src) ||
+        !String::NewFromUtf8(iso, origin.data(), NewStringType::kNormal,
+                             origin.size())
+             .ToLocal(&ogn)) {
+      rtn.error = ExceptionError(try_catch, iso, local_ctx);
+      return rtn;
+    }
+    ScriptOrigin script_origin(ogn);
+    ScriptCompiler::Source script_source(src, script_origin);
+    if (!ScriptCompiler::CompileUnboundScript(iso, &script_source)
+             .ToLocal(&unbound_script)) {
+      rtn.error = ExceptionError(try_catch, iso, local_ctx);
+      return rtn;
+    }
+    cache->Insert(iso, source, origin, unbound_script);
+  }
+
+  Local<Value> result;
+  if (!unbound_script->BindToCurrentContext()->Run(local_ctx).ToLocal(
+          &result)) {
+    rtn.error = ExceptionError(try_catch, iso, local_ctx);
+    return rtn;
+  }
+  rtn.value = tracked_value(ctx, result);
   return rtn;
 }
+
+RtnValue RunScript(ContextPtr ctx,
+                   const char* source,
+                   int source_len,
+                   const char* origin,
+                   int origin_len) {
+  LOCAL_CONTEXT(ctx);
+  if (m_compileCache* cache = isolateInternalContext(iso)->compileCache) {
+    return runCachedScript(ctx, iso, local_ctx, try_catch, cache,
+                           std::string_view(source, source_len),
+                           std::string_view(origin, origin_len));
+  }
+  return runScript(
+      ctx, iso, local_ctx, try_catch,
+      String::NewFromUtf8(iso, source, NewStringType::kNormal, source_len),
+      origin, origin_len);
+}
+
+RtnValue RunScriptSource(ContextPtr ctx,
+                         ScriptSourcePtr source,
+                         const char* origin,
+                         int origin_len) {
+  LOCAL_CONTEXT(ctx);
+  return runScript(ctx, iso, local_ctx, try_catch,
+                   ScriptSourceString(iso, source), origin, origin_len);
+}
@@ -6,31 +6,24 @@ package v8go
 
 // #include <stdlib.h>
 // #include "context.h"
+// #include "value.h"
 import "C"
 import (
 	"runtime"
-	"sync"
-	"unsafe"
 )
 
-// Due to the limitations of passing pointers to C from Go we need to create
-// a registry so that we can lookup the Context from any given callback from V8.
-// This is similar to what is described here: https://github.com/golang/go/wiki/cgo#function-variables
-type ctxRef struct {
-	ctx      *Context
-	refCount int
-}
-
-var ctxMutex sync.RWMutex
-var ctxRegistry = make(map[int]*ctxRef)
-var ctxSeq = 0
-
 // Context is a global root execution environment that allows separate,
 // unrelated, JavaScript applications to run in a single instance of V8.
 type Context struct {
+	// ref identifies the context in its isolate's context table, so that
+	// callbacks from V8 can find it.
 	ref int
 	ptr C.ContextPtr
 	iso *Isolate
+
+	// released holds the ids of values finalized by Go when the isolate was
+	// created WithAutoRelease.
+	released releaseQueue[C.long]
 }
 
 type contextOptions struct {
@@ -61,17 +54,10 @@ func NewContext(opt ...ContextOption) *Context {
 		opts.gTmpl = &ObjectTemplate{&template{}}
 	}
 
-	ctxMutex.Lock()
-	ctxSeq++
-	ref := ctxSeq
-	ctxMutex.Unlock()
-
-	ctx := &Context{
-		ref: ref,
-		ptr: C.NewContext(opts.iso.ptr, opts.gTmpl.ptr, C.int(ref)),
-		iso: opts.iso,
-	}
-	ctx.register()
+	opts.iso.releaseTemplates()
+	ctx := &Context{iso: opts.iso}
+	ctx.ref = opts.iso.ctxs.add(ctx)
+	ctx.ptr = C.NewContext(opts.iso.ptr, opts.gTmpl.ptr, C.int(ctx.ref))
 	runtime.KeepAlive(opts.gTmpl)
 	return ctx
 }
@@ -81,9 +67,9 @@ func (c *Context) Isolate() *Isolate {
 	return c.iso
 }
 
+// RetainedValueCount returns the number of values tracked by the context that
+// have not been released yet.
 func (c *Context) RetainedValueCount() int {
-	ctxMutex.Lock()
-	defer ctxMutex.Unlock()
 	return int(C.ContextRetainedValueCount(c.ptr))
 }
 
@@ -91,12 +77,24 @@ func (c *Context) RetainedValueCount() int {
 // reference for the script and used in the stack trace if there is an error.
 // error will be of type `JSError` if not nil.
 func (c *Context) RunScript(source string, origin string) (*Value, error) {
-	cSource := C.CString(source)
-	cOrigin := C.CString(origin)
-	defer C.free(unsafe.Pointer(cSource))
-	defer C.free(unsafe.Pointer(cOrigin))
+	cSource, sourceLen := cStringN(source)
+	cOrigin, originLen := cStringN(origin)
+
+	c.releaseQueued()
+	rtn := C.RunScript(c.ptr, cSource, sourceLen, cOrigin, originLen)
+	return valueResult(c, rtn)
+}
+
+// RunScriptSource is like RunScript, but runs a ScriptSource, which V8 reads in
+// place instead of copying it into the isolate's heap.
+func (c *Context) RunScriptSource(source *ScriptSource, origin string) (*Value, error) {
+	cOrigin, originLen := cStringN(origin)
 
-	rtn := C.RunScript(c.ptr, cSource, cOrigin)
+	src := source.retain()
+	defer C.ScriptSourceRelease(src)
+
+	c.releaseQueued()
+	rtn := C.RunScriptSource(c.ptr, src, cOrigin, originLen)
 	return valueResult(c, rtn)
 }
 
@@ -109,8 +107,48 @@ func (c *Context) RunScript(source string, origin string) (*Value, error) {
 // global proxy object.
 func (c *Context) Global() *Object {
 	valPtr := C.ContextGlobal(c.ptr)
-	v := &Value{valPtr, c}
-	return &Object{v}
+	return &Object{newValue(valPtr, c)}
+}
+
+// WithValueScope calls fn and then releases every value created in the context
+// while fn was running, in a single call. This gives long-lived contexts the
+// lifetime model of a V8 HandleScope without calling Release on each value.
+//
+// Values that need to outlive fn must be passed to ValueScope.Escape. Scopes
+// can be nested; an escaped value is handed to the enclosing scope, if any.
+// Values created through the Isolate, such as with NewValue, are not owned by
+// the context and are not released by the scope.
+//
+// Using a released value results in undefined behavior, just as after
+// Value.Release. The context must not be closed while fn is running.
+func (c *Context) WithValueScope(fn func(scope *ValueScope)) {
+	depth := C.ContextPushValueScope(c.ptr)
+	defer func() {
+		if c.ptr != nil {
+			C.ContextPopValueScope(c.ptr)
+		}
+	}()
+	fn(&ValueScope{ctx: c, depth: depth})
+}
+
+// ValueScope is passed to the function given to Context.WithValueScope.
+type ValueScope struct {
+	ctx   *Context
+	depth C.int
+}
+
+// Escape keeps v alive when the scope closes by handing it to the enclosing
+// scope. If there is no enclosing scope, v lives until it is released or the
+// context is closed. Escaping a value again, or a value that already belongs
+// to an enclosing scope, has no effect. v must belong to the scope's context.
+// It returns v's underlying Value for convenience.
+func (s *ValueScope) Escape(v Valuer) *Value {
+	val := v.value()
+	if val.ctx != s.ctx {
+		panic("value of another context can not be escaped")
+	}
+	C.ValueEscape(val.ptr, s.depth)
+	return val
 }
 
 // PerformMicrotaskCheckpoint runs the default MicrotaskQueue until empty.
@@ -122,61 +160,24 @@ func (c *Context) PerformMicrotaskCheckpoint() {
 // Close will dispose the context and free the memory.
 // Access to any values associated with the context after calling Close may panic.
 func (c *Context) Close() {
-	c.deregister()
-	C.ContextFree(c.ptr)
-	c.ptr = nil
-}
-
-func (c *Context) register() {
-	ctxMutex.Lock()
-	r := ctxRegistry[c.ref]
-	if r == nil {
-		r = &ctxRef{ctx: c}
-		ctxRegistry[c.ref] = r
-	}
-	r.refCount++
-	ctxMutex.Unlock()
-}
-
-func (c *Context) deregister() {
-	ctxMutex.Lock()
-	defer ctxMutex.Unlock()
-	r := ctxRegistry[c.ref]
-	if r == nil {
+	if c.ptr == nil {
 		return
 	}
-	r.refCount--
-	if r.refCount <= 0 {
-		delete(ctxRegistry, c.ref)
-	}
-}
-
-func getContext(ref int) *Context {
-	ctxMutex.RLock()
-	defer ctxMutex.RUnlock()
-	r := ctxRegistry[ref]
-	if r == nil {
-		return nil
-	}
-	return r.ctx
-}
-
-//export goContext
-func goContext(ref int) C.ContextPtr {
-	ctx := getContext(ref)
-	return ctx.ptr
+	c.iso.ctxs.remove(c.ref)
+	C.ContextFree(c.ptr)
+	c.ptr = nil
 }
 
 func valueResult(ctx *Context, rtn C.RtnValue) (*Value, error) {
 	if rtn.value == nil {
 		return nil, newJSError(rtn.error)
 	}
-	return &Value{rtn.value, ctx}, nil
+	return newValue(rtn.value, ctx), nil
 }
 
 func objectResult(ctx *Context, rtn C.RtnValue) (*Object, error) {
 	if rtn.value == nil {
 		return nil, newJSError(rtn.error)
 	}
-	return &Object{&Value{rtn.value, ctx}}, nil
+	return &Object{newValue(rtn.value, ctx)}, nil
 }
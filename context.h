@@ -3,33 +3,70 @@
 
 #include "errors.h"
 #include "isolate.h"
+#include "script_source.h"
 
 #ifdef __cplusplus
 
 #include "deps/include/v8-persistent-handle.h"
 
-#include <unordered_map>
+#include <unordered_set>
 #include <vector>
+#include "compile_cache.h"
+#include "key.h"
+#include "slab.h"
 #include "value.h"
+#include "value_table.h"
 
 namespace v8 {
 class Isolate;
 class Context;
+class External;
 }  // namespace v8
 
 typedef v8::Isolate v8Isolate;
 typedef struct m_unboundScript m_unboundScript;
 
+// The data V8 passes to a Go callback. See NewCallbackData.
+struct m_callbackData {
+  v8::Global<v8::External> handle;
+  int ref;
+  int table;
+};
+
 struct m_ctx {
   v8::Isolate* iso;
-  std::unordered_map<long, m_value*> vals;
+  // The reference of the Go Context in its isolate's context table.
+  int ref;
+  m_valueTable vals;
   std::vector<m_unboundScript*> unboundScripts;
   v8::Persistent<v8::Context> ptr;
-  long nextValId;
+
+  // Ids of the values created while value scopes are open, and where each
+  // open scope starts in scopeVals. Ids are appended in creation order, so a
+  // scope owns everything from its mark to the end.
+  std::vector<long> scopeVals;
+  std::vector<size_t> scopeMarks;
+
+  // The data of Go callbacks V8 hasn't collected yet. Only used by the
+  // isolate's internal context, which lives as long as the isolate.
+  std::unordered_set<m_callbackData*> callbackData;
+
+  // Backing storage for vals and unboundScripts. Everything is freed at once
+  // when the context is deleted.
+  m_slab<m_value> valueSlab;
+  m_slab<m_unboundScript, 16> unboundScriptSlab;
+
+  // Backing storage for the isolate's keys. Only used by the internal context.
+  m_slab<m_key, 64> keySlab;
+
+  // The isolate's RunScript cache, if enabled. Only used by the internal
+  // context.
+  m_compileCache* compileCache = nullptr;
 };
 typedef m_ctx* ContextPtr;
 
-extern m_value* tracked_value(m_ctx* ctx, m_value* val);
+extern m_value* tracked_value(m_ctx* ctx, v8::Local<v8::Value> val);
+extern void release_value(m_value* val);
 
 extern "C" {
 #else
@@ -49,9 +86,18 @@ extern ContextPtr NewContext(IsolatePtr iso_ptr,
 extern int ContextRetainedValueCount(ContextPtr ctx);
 extern ValuePtr ContextGlobal(ContextPtr ctx_ptr);
 extern void ContextFree(ContextPtr ctx);
+extern int ContextPushValueScope(ContextPtr ctx);
+extern void ContextPopValueScope(ContextPtr ctx);
+extern void ContextReleaseValueIds(ContextPtr ctx, long* ids, int len);
 extern RtnValue RunScript(ContextPtr ctx_ptr,
                           const char* source,
-                          const char* origin);
+                          int source_len,
+                          const char* origin,
+                          int origin_len);
+extern RtnValue RunScriptSource(ContextPtr ctx_ptr,
+                                ScriptSourcePtr source,
+                                const char* origin,
+                                int origin_len);
 
 #ifdef __cplusplus
 }  // extern "C"
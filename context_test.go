@@ -7,6 +7,7 @@ package v8go_test
 import (
 	"encoding/json"
 	"fmt"
+	"runtime"
 	"testing"
 
 	v8 "github.com/tommie/v8go"
@@ -39,6 +40,25 @@ func TestContextExec(t *testing.T) {
 	}
 }
 
+func TestContextRunScriptNUL(t *testing.T) {
+	t.Parallel()
+	ctx := v8.NewContext(nil)
+	defer ctx.Isolate().Dispose()
+	defer ctx.Close()
+
+	// Strings are passed with their length, so a NUL byte doesn't end them.
+	val, err := ctx.RunScript("const o = {'a\x00b': 1}; 'a\x00b'.length", "nul.js")
+	fatalIf(t, err)
+	if got := val.Int32(); got != 3 {
+		t.Errorf("expected 3, got %d", got)
+	}
+	obj, err := ctx.RunScript("o", "")
+	fatalIf(t, err)
+	if !obj.Object().Has("a\x00b") || obj.Object().Has("a") {
+		t.Error("expected the key to include the NUL byte")
+	}
+}
+
 func TestJSExceptions(t *testing.T) {
 	t.Parallel()
 
@@ -80,7 +100,7 @@ func TestContextRegistry(t *testing.T) {
 
 	ctxref := ctx.Ref()
 
-	c1 := v8.GetContext(ctxref)
+	c1 := ctx.Isolate().GetContext(ctxref)
 	if c1 == nil {
 		t.Error("expected context, but got <nil>")
 	}
@@ -90,12 +110,130 @@ func TestContextRegistry(t *testing.T) {
 
 	ctx.Close()
 
-	c2 := v8.GetContext(ctxref)
+	c2 := ctx.Isolate().GetContext(ctxref)
 	if c2 != nil {
 		t.Error("expected context to be <nil> after close")
 	}
 }
 
+func TestContextRetainedValueCount(t *testing.T) {
+	t.Parallel()
+
+	ctx := v8.NewContext()
+	defer ctx.Isolate().Dispose()
+	defer ctx.Close()
+
+	var vals []*v8.Value
+	for i := 0; i < 10; i++ {
+		val, err := ctx.RunScript("({})", "")
+		fatalIf(t, err)
+		vals = append(vals, val)
+	}
+	if n := ctx.RetainedValueCount(); n != 10 {
+		t.Fatalf("expected 10 retained values, got %d", n)
+	}
+
+	for _, val := range vals[:5] {
+		val.Release()
+	}
+	if n := ctx.RetainedValueCount(); n != 5 {
+		t.Fatalf("expected 5 retained values after release, got %d", n)
+	}
+
+	// Released slots are reused without disturbing the remaining values.
+	for i := 0; i < 5; i++ {
+		_, err := ctx.RunScript("1", "")
+		fatalIf(t, err)
+	}
+	if n := ctx.RetainedValueCount(); n != 10 {
+		t.Fatalf("expected 10 retained values, got %d", n)
+	}
+	for _, val := range vals[5:] {
+		if !val.IsObject() {
+			t.Errorf("expected value to still be an object, got %v", val)
+		}
+	}
+}
+
+func TestContextWithValueScope(t *testing.T) {
+	t.Parallel()
+
+	ctx := v8.NewContext()
+	defer ctx.Isolate().Dispose()
+	defer ctx.Close()
+
+	var kept, released *v8.Value
+	ctx.WithValueScope(func(scope *v8.ValueScope) {
+		for i := 0; i < 100; i++ {
+			_, err := ctx.RunScript("({})", "")
+			fatalIf(t, err)
+		}
+
+		ctx.WithValueScope(func(inner *v8.ValueScope) {
+			val, err := ctx.RunScript("'kept'", "")
+			fatalIf(t, err)
+			kept = scope.Escape(inner.Escape(val))
+
+			released, err = ctx.RunScript("'released'", "")
+			fatalIf(t, err)
+			// Releasing explicitly inside a scope is allowed.
+			released.Release()
+		})
+
+		if n := ctx.RetainedValueCount(); n != 101 {
+			t.Errorf("expected 101 retained values in the outer scope, got %d", n)
+		}
+	})
+
+	if n := ctx.RetainedValueCount(); n != 1 {
+		t.Errorf("expected only the escaped value to be retained, got %d", n)
+	}
+	if s := kept.String(); s != "kept" {
+		t.Errorf("expected escaped value to be usable, got %q", s)
+	}
+}
+
+func TestValueScopeEscapeDepth(t *testing.T) {
+	t.Parallel()
+
+	ctx := v8.NewContext()
+	defer ctx.Isolate().Dispose()
+	defer ctx.Close()
+
+	ctx.WithValueScope(func(scope *v8.ValueScope) {
+		ctx.WithValueScope(func(inner *v8.ValueScope) {
+			val, err := ctx.RunScript("'once'", "")
+			fatalIf(t, err)
+			// Escaping again must not move the value past the outer scope.
+			inner.Escape(inner.Escape(val))
+			val, err = ctx.RunScript("'kept'", "")
+			fatalIf(t, err)
+			// Escaping from the outer scope hands the value to the context,
+			// and a later escape from the inner scope must not undo that.
+			inner.Escape(scope.Escape(val))
+		})
+		if n := ctx.RetainedValueCount(); n != 2 {
+			t.Errorf("expected 2 values escaped from the inner scope, got %d", n)
+		}
+	})
+	if n := ctx.RetainedValueCount(); n != 1 {
+		t.Errorf("expected only the value escaped from the outer scope to be retained, got %d", n)
+	}
+
+	other := v8.NewContext(ctx.Isolate())
+	defer other.Close()
+	val, err := other.RunScript("1", "")
+	fatalIf(t, err)
+	defer func() {
+		if recover() == nil {
+			t.Error("expected escaping a value of another context to panic")
+		}
+	}()
+	ctx.WithValueScope(func(scope *v8.ValueScope) {
+		scope.Escape(val)
+	})
+}
+
 func TestMemoryLeak(t *testing.T) {
 	t.Parallel()
 
@@ -208,3 +346,36 @@ func ExampleContext_globalTemplate() {
 	// Output:
 	// v1.0.0
 }
+
+func TestContextAutoRelease(t *testing.T) {
+	t.Parallel()
+
+	iso := v8.NewIsolate(v8.WithAutoRelease())
+	defer iso.Dispose()
+	ctx := v8.NewContext(iso)
+	defer ctx.Close()
+
+	kept, err := ctx.RunScript("({})", "")
+	fatalIf(t, err)
+	for i := 0; i < 100; i++ {
+		_, err := ctx.RunScript("({})", "")
+		fatalIf(t, err)
+	}
+	explicit, err := ctx.RunScript("({})", "")
+	fatalIf(t, err)
+	explicit.Release()
+
+	// Finalizers run asynchronously after a GC cycle, so allow a few rounds.
+	for i := 0; i < 10 && ctx.RetainedValueCount() > 2; i++ {
+		runtime.GC()
+		_, err := ctx.RunScript("1", "")
+		fatalIf(t, err)
+	}
+	// What remains is kept and the result of the last RunScript.
+	if n := ctx.RetainedValueCount(); n > 2 {
+		t.Errorf("expected collected values to be released, got %d retained", n)
+	}
+	if !kept.IsObject() {
+		t.Errorf("expected the reachable value to be unaffected")
+	}
+}
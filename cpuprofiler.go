@@ -46,10 +46,8 @@ func (c *CPUProfiler) StartProfiling(title string) {
 		panic("profiler or isolate are nil")
 	}
 
-	tstr := C.CString(title)
-	defer C.free(unsafe.Pointer(tstr))
-
-	C.CPUProfilerStartProfiling(c.p, tstr)
+	tstr, n := cStringN(title)
+	C.CPUProfilerStartProfiling(c.p, tstr, n)
 }
 
 // Stops collecting CPU profile with a given title and returns it.
@@ -59,10 +57,8 @@ func (c *CPUProfiler) StopProfiling(title string) *CPUProfile {
 		panic("profiler or isolate are nil")
 	}
 
-	tstr := C.CString(title)
-	defer C.free(unsafe.Pointer(tstr))
-
-	profile := C.CPUProfilerStopProfiling(c.p, tstr)
+	tstr, n := cStringN(title)
+	profile := C.CPUProfilerStopProfiling(c.p, tstr, n)
 
 	return &CPUProfile{
 		p:               profile,
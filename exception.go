@@ -10,6 +10,7 @@ import (
 	"C"
 
 	"fmt"
+	"runtime"
 	"unsafe"
 )
 
@@ -55,9 +56,8 @@ func NewError(iso *Isolate, msg string) *Exception {
 }
 
 func newExceptionError(iso *Isolate, typ C.ErrorTypeIndex, msg string) *Exception {
-	cmsg := C.CString(msg)
-	defer C.free(unsafe.Pointer(cmsg))
-	eptr := C.NewValueError(iso.ptr, typ, cmsg)
+	cmsg, n := cStringN(msg)
+	eptr := C.NewValueError(iso.ptr, typ, cmsg, n)
 	if eptr == nil {
 		panic(fmt.Errorf("invalid error type index: %d", typ))
 	}
@@ -104,6 +104,7 @@ func (e *Exception) String() string {
 		return "<nil>"
 	}
 	s := C.ExceptionGetMessageString(e.ptr)
+	runtime.KeepAlive(e)
 	defer C.free(unsafe.Pointer(s))
 	return C.GoString(s)
 }
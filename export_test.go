@@ -14,8 +14,15 @@ func (i *Isolate) GetCallback(ref int) FunctionCallbackWithError {
 	return i.getCallback(ref)
 }
 
+// CallbackCount is exported for testing only.
+func (i *Isolate) CallbackCount() int {
+	return i.cbs.count() + i.fastCbs.count() + i.props.count()
+}
+
 // GetContext is exported for testing only.
-var GetContext = getContext
+func (i *Isolate) GetContext(ref int) *Context {
+	return i.getContext(ref)
+}
 
 // Ref is exported for testing only.
 func (c *Context) Ref() int {
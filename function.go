@@ -7,6 +7,7 @@ package v8go
 // #include "v8go.h"
 import "C"
 import (
+	"runtime"
 	"unsafe"
 )
 
@@ -17,6 +18,7 @@ type Function struct {
 
 // Call this JavaScript function with the given arguments.
 func (fn *Function) Call(recv Valuer, args ...Valuer) (*Value, error) {
+	fn.ctx.releaseQueued()
 	var argptr *C.ValuePtr
 	if len(args) > 0 {
 		var cArgs = make([]C.ValuePtr, len(args))
@@ -26,11 +28,16 @@ func (fn *Function) Call(recv Valuer, args ...Valuer) (*Value, error) {
 		argptr = (*C.ValuePtr)(unsafe.Pointer(&cArgs[0]))
 	}
 	rtn := C.FunctionCall(fn.ptr, recv.value().ptr, C.int(len(args)), argptr)
+	// The arguments must not be finalized and released while V8 uses them.
+	runtime.KeepAlive(fn)
+	runtime.KeepAlive(recv)
+	runtime.KeepAlive(args)
 	return valueResult(fn.ctx, rtn)
 }
 
 // Invoke a constructor function to create an object instance.
 func (fn *Function) NewInstance(args ...Valuer) (*Object, error) {
+	fn.ctx.releaseQueued()
 	var argptr *C.ValuePtr
 	if len(args) > 0 {
 		var cArgs = make([]C.ValuePtr, len(args))
@@ -40,11 +47,14 @@ func (fn *Function) NewInstance(args ...Valuer) (*Object, error) {
 		argptr = (*C.ValuePtr)(unsafe.Pointer(&cArgs[0]))
 	}
 	rtn := C.FunctionNewInstance(fn.ptr, C.int(len(args)), argptr)
+	runtime.KeepAlive(fn)
+	runtime.KeepAlive(args)
 	return objectResult(fn.ctx, rtn)
 }
 
 // Return the source map url for a function.
 func (fn *Function) SourceMapUrl() *Value {
 	ptr := C.FunctionSourceMapUrl(fn.ptr)
-	return &Value{ptr, fn.ctx}
+	runtime.KeepAlive(fn)
+	return newValue(ptr, fn.ctx)
 }
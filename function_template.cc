@@ -1,55 +1,206 @@
 #include "_cgo_export.h"
 
 #include "deps/include/v8-context.h"
+#include "deps/include/v8-external.h"
+#include "deps/include/v8-fast-api-calls.h"
 #include "deps/include/v8-function.h"
 #include "isolate-macros.h"
+#include "object.h"
 #include "template-macros.h"
 #include "template.h"
 
 using namespace v8;
 
+// m_callbackInfo gives Go access to the arguments of a running scoped
+// callback. Values are only created when Go asks for them, and released when
+// the callback returns unless Go escaped them.
+struct m_callbackInfo {
+  const FunctionCallbackInfo<Value>& info;
+  m_ctx* ctx;
+  std::vector<long> vals;
+};
+
+m_ctx* callbackContext(Isolate* iso) {
+  return static_cast<m_ctx*>(
+      iso->GetCurrentContext()->GetAlignedPointerFromEmbedderData(1));
+}
+
+uintptr_t isolateHandle(Isolate* iso) {
+  return reinterpret_cast<uintptr_t>(iso->GetData(1));
+}
+
+static void CallbackDataCollected(
+    const WeakCallbackInfo<m_callbackData>& info) {
+  Isolate* iso = info.GetIsolate();
+  m_callbackData* data = info.GetParameter();
+  isolateInternalContext(iso)->callbackData.erase(data);
+  data->handle.Reset();
+  goCallbackCollected(isolateHandle(iso), data->table, data->ref);
+  delete data;
+}
+
+Local<Value> NewCallbackData(Isolate* iso,
+                             int callback_ref,
+                             CallbackTable table) {
+  // A Smi would be cheaper, but only heap objects can be watched for
+  // collection.
+  Local<External> external = External::New(
+      iso, reinterpret_cast<void*>(static_cast<intptr_t>(callback_ref)));
+
+  m_callbackData* data = new m_callbackData{{}, callback_ref, table};
+  data->handle.Reset(iso, external);
+  data->handle.SetWeak(data, CallbackDataCollected,
+                       WeakCallbackType::kParameter);
+  isolateInternalContext(iso)->callbackData.insert(data);
+  return external;
+}
+
+int callbackRef(Local<Value> data) {
+  return static_cast<int>(
+      reinterpret_cast<intptr_t>(data.As<External>()->Value()));
+}
+
+static void setCallbackReturn(Isolate* iso,
+                              const FunctionCallbackInfo<Value>& info,
+                              ValuePtr rval,
+                              ValuePtr rerr) {
+  if (rerr != nullptr) {
+    iso->ThrowException(rerr->ptr.Get(iso));
+  } else if (rval != nullptr) {
+    info.GetReturnValue().Set(rval->ptr.Get(iso));
+  } else {
+    info.GetReturnValue().SetUndefined();
+  }
+}
+
 void FunctionTemplateCallback(const FunctionCallbackInfo<Value>& info) {
   Isolate* iso = info.GetIsolate();
   ISOLATE_SCOPE(iso);
 
   // This callback function can be called from any Context, which we only know
-  // at runtime. We extract the Context reference from the embedder data so that
-  // we can use the context registry to match the Context on the Go side
-  Local<Context> local_ctx = iso->GetCurrentContext();
-  int ctx_ref = local_ctx->GetEmbedderData(1).As<Integer>()->Value();
-  m_ctx* ctx = goContext(ctx_ref);
-
-  int callback_ref = info.Data().As<Integer>()->Value();
-
-  m_value* _this = new m_value;
-  _this->id = 0;
-  _this->iso = iso;
-  _this->ctx = ctx;
-  _this->ptr.Reset(iso, Global<Value>(iso, info.This()));
+  // at runtime. We extract the m_ctx from the embedder data; Go finds the
+  // Context through the isolate's handle and the context's ref.
+  m_ctx* ctx = callbackContext(iso);
+  int callback_ref = callbackRef(info.Data());
 
   std::vector<ValuePtr> thisAndArgs(1 + info.Length());
-  thisAndArgs[0] = tracked_value(ctx, _this);
+  thisAndArgs[0] = tracked_value(ctx, info.This());
   for (size_t i = 1; i < thisAndArgs.size(); ++i) {
-    m_value* val = new m_value;
-    val->id = 0;
-    val->iso = iso;
-    val->ctx = ctx;
-    val->ptr.Reset(iso, Global<Value>(iso, info[i - 1]));
-    thisAndArgs[i] = tracked_value(ctx, val);
+    thisAndArgs[i] = tracked_value(ctx, info[i - 1]);
   }
 
   goFunctionCallback_return retval =
-      goFunctionCallback(ctx_ref, callback_ref, thisAndArgs.data(), thisAndArgs.size() - 1);
-  if (retval.r1 != nullptr) {
-    iso->ThrowException(retval.r1->ptr.Get(iso));
-  } else if (retval.r0 != nullptr) {
-    info.GetReturnValue().Set(retval.r0->ptr.Get(iso));
-  } else {
-    info.GetReturnValue().SetUndefined();
+      goFunctionCallback(isolateHandle(iso), ctx->ref, callback_ref,
+                         thisAndArgs.data(), thisAndArgs.size() - 1);
+  setCallbackReturn(iso, info, retval.r0, retval.r1);
+}
+
+void FunctionTemplateScopedCallback(const FunctionCallbackInfo<Value>& info) {
+  Isolate* iso = info.GetIsolate();
+  ISOLATE_SCOPE(iso);
+
+  m_ctx* ctx = callbackContext(iso);
+  int callback_ref = callbackRef(info.Data());
+
+  m_callbackInfo cinfo{info, ctx};
+  goScopedFunctionCallback_return retval = goScopedFunctionCallback(
+      isolateHandle(iso), ctx->ref, callback_ref, &cinfo, info.Length());
+  setCallbackReturn(iso, info, retval.r0, retval.r1);
+
+  // The return value has been copied into V8, so even a returned argument can
+  // be released now. Ids are stale if Go released the value itself.
+  for (long id : cinfo.vals) {
+    m_value* val = ctx->vals.Get(id);
+    if (val != nullptr) {
+      release_value(val);
+    }
+  }
+}
+
+static ValuePtr callbackInfoValue(CallbackInfoPtr info, Local<Value> local) {
+  m_value* val = tracked_value(info->ctx, local);
+  info->vals.push_back(val->header.id);
+  return val;
+}
+
+ValuePtr CallbackInfoThis(CallbackInfoPtr info) {
+  return callbackInfoValue(info, info->info.This());
+}
+
+int CallbackInfoThisAlignedPointer(CallbackInfoPtr info,
+                                   int idx,
+                                   uintptr_t* v) {
+  Local<Object> self = info->info.This();
+  if (idx >= self->InternalFieldCount()) {
+    return 0;
+  }
+  *v = decodeFieldPointer(self->GetAlignedPointerFromInternalField(idx));
+  return 1;
+}
+
+ValuePtr CallbackInfoArg(CallbackInfoPtr info, int i) {
+  return callbackInfoValue(info, info->info[i]);
+}
+
+void CallbackInfoArgs(CallbackInfoPtr info, ValuePtr* args) {
+  for (int i = 0; i < info->info.Length(); ++i) {
+    args[i] = callbackInfoValue(info, info->info[i]);
   }
 }
 
-TemplatePtr NewFunctionTemplate(IsolatePtr iso, int callback_ref) {
+void CallbackInfoEscape(CallbackInfoPtr info, ValuePtr val) {
+  std::vector<long>& vals = info->vals;
+  for (size_t i = 0; i < vals.size(); ++i) {
+    if (vals[i] == val->header.id) {
+      vals.erase(vals.begin() + i);
+      return;
+    }
+  }
+}
+
+// FastFloat64Callback is called directly from optimized code when all
+// arguments are numbers. It must not allocate on the JS heap, which is why it
+// passes raw doubles to Go instead of values.
+template <typename... Args>
+static double FastFloat64Callback(Local<Object> receiver,
+                                  Args... args,
+                                  FastApiCallbackOptions& options) {
+  double argv[] = {args..., 0};
+  int callback_ref = callbackRef(options.data);
+  return goFastFloat64Callback(isolateHandle(options.isolate), callback_ref,
+                               argv, sizeof...(Args));
+}
+
+// FastFloat64SlowCallback is used by the interpreter, and by optimized code
+// when an argument isn't a number. It converts arguments like JS `+arg`.
+static void FastFloat64SlowCallback(const FunctionCallbackInfo<Value>& info) {
+  Isolate* iso = info.GetIsolate();
+  HandleScope handle_scope(iso);
+  Local<Context> local_ctx = iso->GetCurrentContext();
+
+  std::vector<double> argv(info.Length() + 1);
+  for (int i = 0; i < info.Length(); ++i) {
+    if (!info[i]->NumberValue(local_ctx).To(&argv[i])) {
+      return;
+    }
+  }
+
+  int callback_ref = callbackRef(info.Data());
+  info.GetReturnValue().Set(goFastFloat64Callback(
+      isolateHandle(iso), callback_ref, argv.data(), info.Length()));
+}
+
+static const CFunction fastFloat64Callbacks[] = {
+    CFunction::Make(FastFloat64Callback<>),
+    CFunction::Make(FastFloat64Callback<double>),
+    CFunction::Make(FastFloat64Callback<double, double>),
+    CFunction::Make(FastFloat64Callback<double, double, double>),
+    CFunction::Make(FastFloat64Callback<double, double, double, double>),
+};
+
+TemplatePtr NewFunctionTemplate(IsolatePtr iso,
+                                int callback_ref,
+                                int scoped_args) {
   Locker locker(iso);
   Isolate::Scope isolate_scope(iso);
   HandleScope handle_scope(iso);
@@ -58,12 +209,34 @@ TemplatePtr NewFunctionTemplate(IsolatePtr iso, int callback_ref) {
   // C++ callback function data, but if we needed to store more items we could
   // use an V8::Array; this would require the internal context from
   // iso->GetData(0)
-  Local<Integer> cbData = Integer::New(iso, callback_ref);
+  Local<Value> cbData =
+      NewCallbackData(iso, callback_ref, CALLBACK_TABLE_FUNCTION);
+
+  m_template* ot = new m_template;
+  ot->iso = iso;
+  ot->ptr.Reset(iso, FunctionTemplate::New(iso,
+                                           scoped_args
+                                               ? FunctionTemplateScopedCallback
+                                               : FunctionTemplateCallback,
+                                           cbData));
+  return ot;
+}
+
+TemplatePtr NewFastFunctionTemplate(IsolatePtr iso, int callback_ref, int argc) {
+  Locker locker(iso);
+  Isolate::Scope isolate_scope(iso);
+  HandleScope handle_scope(iso);
+
+  Local<Value> cbData = NewCallbackData(iso, callback_ref, CALLBACK_TABLE_FAST);
 
   m_template* ot = new m_template;
   ot->iso = iso;
-  ot->ptr.Reset(iso,
-                FunctionTemplate::New(iso, FunctionTemplateCallback, cbData));
+  ot->ptr.Reset(
+      iso, FunctionTemplate::New(iso, FastFloat64SlowCallback, cbData,
+                                 Local<Signature>(), argc,
+                                 ConstructorBehavior::kThrow,
+                                 SideEffectType::kHasSideEffect,
+                                 &fastFloat64Callbacks[argc]));
   return ot;
 }
 
@@ -81,12 +254,7 @@ RtnValue FunctionTemplateGetFunction(m_template* ptr, m_ctx* ctx) {
     return rtn;
   }
 
-  m_value* val = new m_value;
-  val->id = 0;
-  val->iso = iso;
-  val->ctx = ctx;
-  val->ptr = Global<Value>(iso, fn);
-  rtn.value = tracked_value(ctx, val);
+  rtn.value = tracked_value(ctx, fn);
   return rtn;
 }
 
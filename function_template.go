@@ -4,10 +4,13 @@
 
 package v8go
 
+// #include <stdint.h>
 // #include <stdlib.h>
 // #include "function_template.h"
 import "C"
 import (
+	"fmt"
+	"math"
 	"runtime"
 	"unsafe"
 )
@@ -26,6 +29,12 @@ type FunctionCallbackInfo struct {
 	ctx  *Context
 	args []*Value
 	this *Object
+
+	// cinfo is set while a callback of an isolate created
+	// WithScopedCallbackArgs is running. args and this are then filled in
+	// lazily, and args may be partially filled.
+	cinfo C.CallbackInfoPtr
+	argc  int
 }
 
 // A ValueError can be returned from a FunctionCallbackWithError, and
@@ -42,19 +51,94 @@ func (i *FunctionCallbackInfo) Context() *Context {
 
 // This returns the receiver object "this".
 func (i *FunctionCallbackInfo) This() *Object {
+	if i.this == nil && i.cinfo != nil {
+		i.this = &Object{newValue(C.CallbackInfoThis(i.cinfo), i.ctx)}
+	}
 	return i.this
 }
 
+// ThisAlignedPointer returns This().GetAlignedPointerFromInternalField(idx).
+// For callbacks of isolates created WithScopedCallbackArgs, it reads the field
+// without creating a value for the receiver.
+func (i *FunctionCallbackInfo) ThisAlignedPointer(idx uint32) uintptr {
+	if i.this != nil || i.cinfo == nil {
+		return i.This().GetAlignedPointerFromInternalField(idx)
+	}
+	var v C.uintptr_t
+	if C.CallbackInfoThisAlignedPointer(i.cinfo, C.int(idx), &v) == 0 {
+		panic(fmt.Errorf("index out of range [%v] with length %v", idx, i.This().InternalFieldCount()))
+	}
+	return uintptr(v)
+}
+
 // Args returns a slice of the value arguments that are passed to the JS function.
 func (i *FunctionCallbackInfo) Args() []*Value {
+	if i.cinfo == nil {
+		return i.args
+	}
+	if len(i.args) == 0 && i.argc > 0 {
+		ptrs := make([]C.ValuePtr, i.argc)
+		C.CallbackInfoArgs(i.cinfo, &ptrs[0])
+		i.args = make([]*Value, i.argc)
+		for n, ptr := range ptrs {
+			i.args[n] = newValue(ptr, i.ctx)
+		}
+	} else {
+		for n := range i.args {
+			i.Arg(n)
+		}
+	}
 	return i.args
 }
 
+// Length returns the number of arguments passed to the JS function.
+func (i *FunctionCallbackInfo) Length() int {
+	if i.cinfo != nil {
+		return i.argc
+	}
+	return len(i.args)
+}
+
+// Arg returns the argument at index n, or nil if fewer arguments were passed.
+// For callbacks of isolates created WithScopedCallbackArgs, only the arguments
+// that are used are turned into values.
+func (i *FunctionCallbackInfo) Arg(n int) *Value {
+	if n < 0 || n >= i.Length() {
+		return nil
+	}
+	if i.cinfo == nil {
+		return i.args[n]
+	}
+	if len(i.args) == 0 {
+		i.args = make([]*Value, i.argc)
+	}
+	if i.args[n] == nil {
+		i.args[n] = newValue(C.CallbackInfoArg(i.cinfo, C.int(n)), i.ctx)
+	}
+	return i.args[n]
+}
+
+// Escape keeps v alive after a callback of an isolate created
+// WithScopedCallbackArgs returns. It does nothing for other callbacks, where
+// arguments are never released automatically. It returns v's underlying Value
+// for convenience.
+func (i *FunctionCallbackInfo) Escape(v Valuer) *Value {
+	val := v.value()
+	if i.cinfo != nil {
+		C.CallbackInfoEscape(i.cinfo, val.ptr)
+	}
+	return val
+}
+
 func (i *FunctionCallbackInfo) Release() {
 	for _, arg := range i.args {
-		arg.Release()
+		if arg != nil {
+			arg.Release()
+		}
+	}
+	if i.this != nil {
+		i.this.Release()
 	}
-	i.this.Release()
 }
 
 // FunctionTemplate is used to create functions at runtime.
@@ -96,16 +180,102 @@ func NewFunctionTemplateWithError(
 		panic("nil FunctionCallback argument not supported")
 	}
 
+	iso.releaseTemplates()
 	cbref := iso.registerCallback(callback)
+	var scopedArgs C.int
+	if iso.scopedCallbackArgs {
+		scopedArgs = 1
+	}
 
 	tmpl := &template{
-		ptr: C.NewFunctionTemplate(iso.ptr, C.int(cbref)),
+		ptr: C.NewFunctionTemplate(iso.ptr, C.int(cbref), scopedArgs),
 		iso: iso,
 	}
 	runtime.SetFinalizer(tmpl, (*template).finalizer)
 	return &FunctionTemplate{tmpl}
 }
 
+// FastFloat64Callback is a callback that V8 can call directly from optimized
+// code. It receives the JS arguments converted to numbers, and its result is
+// returned to JS as a number. The args slice is only valid during the call.
+//
+// The callback must not use the isolate in any way: it may be running in the
+// middle of optimized JavaScript code, where V8 can't handle re-entrance.
+type FastFloat64Callback func(args []float64) float64
+
+// MaxFastFunctionArgs is the largest argument count supported by
+// NewFastFunctionTemplate.
+const MaxFastFunctionArgs = 4
+
+type fastCallback struct {
+	argc int
+	fn   FastFloat64Callback
+}
+
+// NewFastFunctionTemplate creates a FunctionTemplate whose functions take argc
+// numeric arguments and return a number, like `Math.hypot`. Optimized code
+// calls the callback through the V8 Fast API, without creating any values or
+// taking the isolate lock. Otherwise, the arguments are converted as by
+// `Number(arg)`; missing arguments are NaN and extra arguments are ignored.
+//
+// It panics if argc is negative or larger than MaxFastFunctionArgs.
+// Functions created from the template can't be used as constructors.
+func NewFastFunctionTemplate(iso *Isolate, argc int, callback FastFloat64Callback) *FunctionTemplate {
+	if iso == nil {
+		panic("nil Isolate argument not supported")
+	}
+	if callback == nil {
+		panic("nil FastFloat64Callback argument not supported")
+	}
+	if argc < 0 || argc > MaxFastFunctionArgs {
+		panic("unsupported argument count for a fast function")
+	}
+
+	iso.releaseTemplates()
+	ref := iso.fastCbs.add(&fastCallback{argc: argc, fn: callback})
+
+	tmpl := &template{
+		ptr: C.NewFastFunctionTemplate(iso.ptr, C.int(ref), C.int(argc)),
+		iso: iso,
+	}
+	runtime.SetFinalizer(tmpl, (*template).finalizer)
+	return &FunctionTemplate{tmpl}
+}
+
+//export goCallbackCollected
+func goCallbackCollected(isoHandle C.uintptr_t, table C.int, cbref C.int) {
+	iso := isolateFromHandle(isoHandle)
+	switch table {
+	case C.CALLBACK_TABLE_FUNCTION:
+		iso.cbs.remove(int(cbref))
+	case C.CALLBACK_TABLE_FAST:
+		iso.fastCbs.remove(int(cbref))
+	case C.CALLBACK_TABLE_PROPERTY:
+		iso.props.remove(int(cbref))
+	}
+}
+
+//export goFastFloat64Callback
+func goFastFloat64Callback(isoHandle C.uintptr_t, cbref C.int, args *C.double, argc C.int) C.double {
+	cb := isolateFromHandle(isoHandle).fastCbs.get(int(cbref))
+
+	var argv []float64
+	if argc > 0 {
+		argv = unsafe.Slice((*float64)(unsafe.Pointer(args)), int(argc))
+	}
+	if len(argv) >= cb.argc {
+		argv = argv[:cb.argc]
+	} else {
+		padded := make([]float64, cb.argc)
+		copy(padded, argv)
+		for i := len(argv); i < cb.argc; i++ {
+			padded[i] = math.NaN()
+		}
+		argv = padded
+	}
+	return C.double(cb.fn(argv))
+}
+
 // GetFunction returns an instance of this function template bound to the given context.
 func (tmpl *FunctionTemplate) GetFunction(ctx *Context) *Function {
 	rtn := C.FunctionTemplateGetFunction(tmpl.ptr, ctx.ptr)
@@ -182,40 +352,71 @@ func (tmpl *FunctionTemplate) Inherit(base *FunctionTemplate) {
 //
 //export goFunctionCallback
 func goFunctionCallback(
+	isoHandle C.uintptr_t,
 	ctxref int,
 	cbref int,
 	thisAndArgs *C.ValuePtr,
 	argsCount int,
 ) (rval C.ValuePtr, rerr C.ValuePtr) {
-	ctx := getContext(ctxref)
+	ctx := isolateFromHandle(isoHandle).getContext(ctxref)
+	ctx.releaseQueued()
 
 	this := *thisAndArgs
 	info := &FunctionCallbackInfo{
 		ctx:  ctx,
-		this: &Object{&Value{ptr: this, ctx: ctx}},
+		this: &Object{newValue(this, ctx)},
 		args: make([]*Value, argsCount),
 	}
 
 	argv := (*[1 << 30]C.ValuePtr)(unsafe.Pointer(thisAndArgs))[1 : argsCount+1 : argsCount+1]
 	for i, v := range argv {
-		val := &Value{ptr: v, ctx: ctx}
-		info.args[i] = val
+		info.args[i] = newValue(v, ctx)
 	}
 
+	return runFunctionCallback(ctx, cbref, info)
+}
+
+//export goScopedFunctionCallback
+func goScopedFunctionCallback(
+	isoHandle C.uintptr_t,
+	ctxref int,
+	cbref int,
+	cinfo C.CallbackInfoPtr,
+	argsCount int,
+) (rval C.ValuePtr, rerr C.ValuePtr) {
+	ctx := isolateFromHandle(isoHandle).getContext(ctxref)
+	ctx.releaseQueued()
+
+	info := &FunctionCallbackInfo{
+		ctx:   ctx,
+		cinfo: cinfo,
+		argc:  argsCount,
+	}
+	defer func() { info.cinfo = nil }()
+	return runFunctionCallback(ctx, cbref, info)
+}
+
+func runFunctionCallback(ctx *Context, cbref int, info *FunctionCallbackInfo) (rval C.ValuePtr, rerr C.ValuePtr) {
 	callbackFunc := ctx.iso.getCallback(cbref)
 	val, err := callbackFunc(info)
 	if err != nil {
-		if verr, ok := err.(ValueError); ok {
-			return nil, verr.value().ptr
-		}
-		errv, err := NewValue(ctx.iso, err.Error())
-		if err != nil {
-			panic(err)
-		}
-		return nil, errv.ptr
+		return nil, callbackError(ctx, err)
 	}
 	if val == nil {
 		return nil, nil
 	}
 	return val.ptr, nil
 }
+
+// callbackError returns the value to throw for an error returned by a Go
+// callback.
+func callbackError(ctx *Context, err error) C.ValuePtr {
+	if verr, ok := err.(ValueError); ok {
+		return verr.value().ptr
+	}
+	errv, err := NewValue(ctx.iso, err.Error())
+	if err != nil {
+		panic(err)
+	}
+	return errv.ptr
+}
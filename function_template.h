@@ -1,17 +1,46 @@
 #ifndef V8GO_FUNCTION_TEMPLATE_H
 #define V8GO_FUNCTION_TEMPLATE_H
 
+#include <stdint.h>
+
 #include "errors.h"
 
+// The Go table a callback reference belongs to.
+typedef enum {
+  CALLBACK_TABLE_FUNCTION = 0,
+  CALLBACK_TABLE_FAST,
+  CALLBACK_TABLE_PROPERTY,
+} CallbackTable;
+
+typedef struct m_ctx m_ctx;
+
 #ifdef __cplusplus
 
+#include "deps/include/v8-local-handle.h"
+
 namespace v8 {
 class Isolate;
+class Value;
 template <class F>
 class FunctionCallbackInfo;
 }  // namespace v8
 
+// NewCallbackData returns the data to pass to V8 along with a Go callback.
+// Once V8 has collected it, and with it every function that could call the
+// callback, the callback is removed from the Go table.
+v8::Local<v8::Value> NewCallbackData(v8::Isolate* iso,
+                                     int callback_ref,
+                                     CallbackTable table);
+
+// Helpers for callbacks into Go: the m_ctx of the running context, the handle
+// of the Go Isolate, and the callback reference in data from NewCallbackData.
+m_ctx* callbackContext(v8::Isolate* iso);
+uintptr_t isolateHandle(v8::Isolate* iso);
+int callbackRef(v8::Local<v8::Value> data);
+
 void FunctionTemplateCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+void FunctionTemplateScopedCallback(
+    const v8::FunctionCallbackInfo<v8::Value>& info);
 
 typedef v8::Isolate v8Isolate;
 
@@ -23,14 +52,28 @@ typedef struct v8Isolate v8Isolate;
 #endif
 
 typedef struct m_template m_template;
-typedef struct m_ctx m_ctx;
+typedef struct m_callbackInfo m_callbackInfo;
+typedef m_callbackInfo* CallbackInfoPtr;
 
-extern m_template* NewFunctionTemplate(v8Isolate* iso_ptr, int callback_ref);
+extern m_template* NewFunctionTemplate(v8Isolate* iso_ptr,
+                                       int callback_ref,
+                                       int scoped_args);
+extern m_template* NewFastFunctionTemplate(v8Isolate* iso_ptr,
+                                           int callback_ref,
+                                           int argc);
 extern RtnValue FunctionTemplateGetFunction(m_template* ptr, m_ctx* ctx_ptr);
 extern m_template* FunctionTemplateInstanceTemplate(m_template* ptr);
 extern m_template* FunctionTemplatePrototypeTemplate(m_template* ptr);
 extern void FunctionTemplateInherit(m_template* ptr, m_template* base);
 
+extern ValuePtr CallbackInfoThis(CallbackInfoPtr info);
+extern int CallbackInfoThisAlignedPointer(CallbackInfoPtr info,
+                                          int idx,
+                                          uintptr_t* v);
+extern ValuePtr CallbackInfoArg(CallbackInfoPtr info, int i);
+extern void CallbackInfoArgs(CallbackInfoPtr info, ValuePtr* args);
+extern void CallbackInfoEscape(CallbackInfoPtr info, ValuePtr val);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
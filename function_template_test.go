@@ -6,6 +6,7 @@ package v8go_test
 
 import (
 	"fmt"
+	"runtime"
 	"strings"
 	"testing"
 
@@ -89,6 +90,73 @@ func TestFunctionTemplate_releases_values(t *testing.T) {
 	}
 }
 
+func TestFunctionTemplate_scoped_args(t *testing.T) {
+	t.Parallel()
+
+	iso := v8.NewIsolate(v8.WithScopedCallbackArgs())
+	defer iso.Dispose()
+	global := v8.NewObjectTemplate(iso)
+	var kept *v8.Value
+	keepfn := v8.NewFunctionTemplate(iso, func(info *v8.FunctionCallbackInfo) *v8.Value {
+		if info.Length() != 4 {
+			t.Errorf("expected 4 arguments, got %d", info.Length())
+		}
+		if info.Arg(4) != nil {
+			t.Errorf("expected nil for a missing argument")
+		}
+		kept = info.Escape(info.Arg(1))
+		return info.Arg(0)
+	})
+	global.Set("keep", keepfn, v8.ReadOnly)
+	ctx := v8.NewContext(iso, global)
+	defer ctx.Close()
+
+	val, err := ctx.RunScript("keep('foo', 'bar', 0, 1)", "")
+	fatalIf(t, err)
+	if s := val.String(); s != "foo" {
+		t.Errorf("expected the returned argument to be foo, got %q", s)
+	}
+	// The result and the escaped argument.
+	if n := ctx.RetainedValueCount(); n != 2 {
+		t.Errorf("expected 2 retained values, got: %d", n)
+	}
+	if s := kept.String(); s != "bar" {
+		t.Errorf("expected the escaped argument to be bar, got %q", s)
+	}
+}
+
+func TestFunctionTemplate_unregisters_callbacks(t *testing.T) {
+	t.Parallel()
+
+	iso := v8.NewIsolate()
+	defer iso.Dispose()
+
+	newTemplates := func() {
+		for i := 0; i < 10; i++ {
+			v8.NewFunctionTemplate(iso, func(*v8.FunctionCallbackInfo) *v8.Value { return nil })
+		}
+	}
+	newTemplates()
+	if n := iso.CallbackCount(); n != 10 {
+		t.Fatalf("expected 10 callbacks, got %d", n)
+	}
+
+	// Go finalizes the templates, then V8 collects them and their callbacks.
+	for i := 0; i < 10 && iso.CallbackCount() > 0; i++ {
+		runtime.GC()
+		iso.LowMemoryNotification()
+	}
+	if n := iso.CallbackCount(); n != 0 {
+		t.Errorf("expected callbacks to be unregistered, got %d", n)
+	}
+
+	// Freed references are handed out again.
+	newTemplates()
+	if n := iso.CallbackCount(); n != 10 {
+		t.Errorf("expected 10 callbacks, got %d", n)
+	}
+}
+
 func TestFunctionTemplateGetFunction(t *testing.T) {
 	t.Parallel()
 
@@ -184,6 +252,46 @@ func TestFunctionTemplateGetFunction(t *testing.T) {
 	})
 }
 
+func TestFastFunctionTemplate(t *testing.T) {
+	t.Parallel()
+
+	iso := v8.NewIsolate()
+	defer iso.Dispose()
+	global := v8.NewObjectTemplate(iso)
+	add := v8.NewFastFunctionTemplate(iso, 2, func(args []float64) float64 {
+		return args[0] + args[1]
+	})
+	fatalIf(t, global.Set("add", add))
+	ctx := v8.NewContext(iso, global)
+	defer ctx.Close()
+
+	tests := [...]struct {
+		source string
+		want   string
+	}{
+		{"add(1, 2)", "3"},
+		{"add('1', true)", "2"},
+		{"add(1)", "NaN"},
+		{"add(1, 2, 3)", "3"},
+		// Gives V8 the chance to optimize the call site into a fast call.
+		{"let s = 0; for (let i = 0; i < 100000; i++) s = add(s, 1); s", "100000"},
+	}
+	for _, tt := range tests {
+		val, err := ctx.RunScript(tt.source, "")
+		fatalIf(t, err)
+		if got := val.String(); got != tt.want {
+			t.Errorf("%s: expected %s, got %s", tt.source, tt.want, got)
+		}
+	}
+
+	tooMany := func() {
+		v8.NewFastFunctionTemplate(iso, v8.MaxFastFunctionArgs+1, func([]float64) float64 { return 0 })
+	}
+	if recoverPanic(tooMany) == nil {
+		t.Error("expected panic for too many arguments")
+	}
+}
+
 func TestFunctionCallbackInfoThis(t *testing.T) {
 	t.Parallel()
 
@@ -361,6 +469,40 @@ func TestFunctionTemplate_inherit(t *testing.T) {
 	}
 }
 
+// BenchmarkFunctionCallbackParallel calls a Go callback from JS in one isolate
+// per goroutine. Run it with e.g. -cpu=1,2,4,8 to check that callback dispatch
+// scales with GOMAXPROCS.
+func BenchmarkFunctionCallbackParallel(b *testing.B) {
+	b.ReportAllocs()
+	b.RunParallel(func(pb *testing.PB) {
+		iso := v8.NewIsolate(v8.WithScopedCallbackArgs())
+		defer iso.Dispose()
+		global := v8.NewObjectTemplate(iso)
+		nop := v8.NewFunctionTemplate(iso, func(*v8.FunctionCallbackInfo) *v8.Value { return nil })
+		if err := global.Set("nop", nop); err != nil {
+			b.Error(err)
+			return
+		}
+		ctx := v8.NewContext(iso, global)
+		defer ctx.Close()
+		loop, err := ctx.RunScript("(function() { for (let i = 0; i < 100; i++) nop(); })", "")
+		if err != nil {
+			b.Error(err)
+			return
+		}
+		fn, _ := loop.AsFunction()
+		undefined := v8.Undefined(iso)
+
+		for pb.Next() {
+			ctx.WithValueScope(func(*v8.ValueScope) {
+				if _, err := fn.Call(undefined); err != nil {
+					b.Error(err)
+				}
+			})
+		}
+	})
+}
+
 func ExampleFunctionTemplate() {
 	iso := v8.NewIsolate()
 	defer iso.Dispose()
@@ -5,6 +5,8 @@
 package v8go_test
 
 import (
+	"fmt"
+	"runtime"
 	"testing"
 
 	v8 "github.com/tommie/v8go"
@@ -35,6 +37,33 @@ func TestFunctionCall(t *testing.T) {
 	}
 }
 
+func TestFunctionCallAutoRelease(t *testing.T) {
+	t.Parallel()
+
+	iso := v8.NewIsolate(v8.WithAutoRelease())
+	defer iso.Dispose()
+	ctx := v8.NewContext(iso)
+	defer ctx.Close()
+
+	val, err := ctx.RunScript("(function(o) { return o.n * 2; })", "")
+	fatalIf(t, err)
+	fn, err := val.AsFunction()
+	fatalIf(t, err)
+
+	// Arguments the caller drops right away must stay alive for the call,
+	// even when the garbage collector finalizes them in the meantime.
+	for i := 0; i < 100; i++ {
+		arg, err := ctx.RunScript(fmt.Sprintf("({ n: %d })", i), "")
+		fatalIf(t, err)
+		runtime.GC()
+		rtn, err := fn.Call(ctx.Global(), arg)
+		fatalIf(t, err)
+		if got := rtn.Int32(); got != int32(i*2) {
+			t.Fatalf("expected %d, got %d", i*2, got)
+		}
+	}
+}
+
 func TestFunctionCallToGoFunc(t *testing.T) {
 	t.Parallel()
 
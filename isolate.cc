@@ -12,6 +12,18 @@ using namespace v8;
 auto default_platform = platform::NewDefaultPlatform();
 ArrayBuffer::Allocator* default_allocator;
 
+// m_isolateSession keeps an isolate locked and entered on the current thread
+// between IsolateEnter and IsolateExit. Lockers are recursive, so sessions can
+// be nested, and a session opened on another thread waits for the lock. The
+// Locker and Isolate::Scope opened by each call made in the meantime are
+// nested, and don't contend for the lock.
+struct m_isolateSession {
+  explicit m_isolateSession(Isolate* iso) : locker(iso), isolate_scope(iso) {}
+
+  Locker locker;
+  Isolate::Scope isolate_scope;
+};
+
 extern "C" {
 
 /********** Isolate **********/
@@ -41,7 +53,7 @@ size_t NearMemoryLimitCallback(void* data, size_t current_heap_limit, size_t ini
   return current_heap_limit * 2;
 }
 
-IsolatePtr NewIsolate(IsolateConstraintsPtr constraints) {
+IsolatePtr NewIsolate(IsolateConstraintsPtr constraints, uintptr_t handle) {
   Isolate::CreateParams params;
   params.array_buffer_allocator = default_allocator;
 
@@ -65,10 +77,12 @@ IsolatePtr NewIsolate(IsolateConstraintsPtr constraints) {
   iso->AddNearHeapLimitCallback(NearMemoryLimitCallback, iso);
 
   // Create a Context for internal use
-  m_ctx* ctx = new m_ctx;
+  m_ctx* ctx = new m_ctx{};
   ctx->ptr.Reset(iso, Context::New(iso));
   ctx->iso = iso;
   iso->SetData(0, ctx);
+  // The Go Isolate's cgo.Handle, passed back to Go by callbacks.
+  iso->SetData(1, reinterpret_cast<void*>(handle));
 
   return iso;
 }
@@ -78,6 +92,11 @@ void IsolatePerformMicrotaskCheckpoint(IsolatePtr iso) {
   iso->PerformMicrotaskCheckpoint();
 }
 
+void IsolateLowMemoryNotification(IsolatePtr iso) {
+  ISOLATE_SCOPE(iso)
+  iso->LowMemoryNotification();
+}
+
 void IsolateDispose(IsolatePtr iso) {
   if (iso == nullptr) {
     return;
@@ -88,6 +107,18 @@ void IsolateDispose(IsolatePtr iso) {
   iso->Dispose();
 }
 
+IsolateSessionPtr IsolateEnter(IsolatePtr iso) {
+  return new m_isolateSession(iso);
+}
+
+void IsolateExit(IsolateSessionPtr session) {
+  delete session;
+}
+
+int IsolateIsLockedByCurrentThread(IsolatePtr iso) {
+  return Locker::IsLocked(iso);
+}
+
 void IsolateTerminateExecution(IsolatePtr iso) {
   iso->TerminateExecution();
 }
@@ -5,11 +5,16 @@
 package v8go
 
 // #include <stdlib.h>
+// #include "compile_cache.h"
 // #include "isolate.h"
+// #include "template.h"
 import "C"
 
 import (
+	"runtime"
+	"runtime/cgo"
 	"sync"
+	"sync/atomic"
 	"unsafe"
 )
 
@@ -19,12 +24,33 @@ import (
 type Isolate struct {
 	ptr C.IsolatePtr
 
-	cbMutex sync.RWMutex
-	cbSeq   int
-	cbs     map[int]FunctionCallbackWithError
+	// handle lets callbacks from V8 find the isolate; it is stored in the
+	// isolate's data slot 1.
+	handle cgo.Handle
+
+	ctxs    refTable[Context]
+	cbs     refTable[FunctionCallbackWithError]
+	fastCbs refTable[fastCallback]
+	props   refTable[propertyHandler]
 
 	null      *Value
 	undefined *Value
+
+	autoRelease        bool
+	scopedCallbackArgs bool
+
+	// releasedTemplates holds the templates finalized by Go. They are
+	// released when the next template or context is created.
+	releasedTemplates releaseQueue[C.TemplatePtr]
+	disposed          atomic.Bool
+
+	// sessions are the sessions opened by Enter, innermost last. They all
+	// belong to the thread holding the isolate lock.
+	sessionsMu sync.Mutex
+	sessions   []C.IsolateSessionPtr
+
+	keysMu sync.Mutex
+	keys   map[string]*Key
 }
 
 // HeapStatistics represents V8 isolate heap statistics
@@ -53,6 +79,14 @@ type IsolateOption func(*isolateConfig)
 // isolateConfig holds the configuration for creating an isolate.
 type isolateConfig struct {
 	resourceConstraints *resourceConstraints
+	autoRelease         bool
+	scopedCallbackArgs  bool
+	compileCache        *compileCacheConfig
+}
+
+type compileCacheConfig struct {
+	maxEntries int
+	maxBytes   int
 }
 
 // WithResourceConstraints sets memory constraints for the isolate.
@@ -66,6 +100,44 @@ func WithResourceConstraints(initialHeapSizeInBytes, maxHeapSizeInBytes uint64)
 	}
 }
 
+// WithAutoRelease makes values owned by the isolate's contexts release
+// themselves once they are garbage collected by Go. Finalized values are
+// queued without touching the isolate, and released in a batch the next time
+// the context runs a script, calls a function or calls back into Go.
+//
+// Calling Release explicitly is still possible, and still the fastest way to
+// free a value. Values not owned by a context, such as those created with
+// NewValue, are not affected.
+func WithAutoRelease() IsolateOption {
+	return func(config *isolateConfig) {
+		config.autoRelease = true
+	}
+}
+
+// WithScopedCallbackArgs changes the callbacks of function templates created
+// in the isolate so that `this` and the arguments are only turned into values
+// when the callback asks for them, and are released when it returns. Values
+// that must outlive the callback have to be passed to
+// FunctionCallbackInfo.Escape. The FunctionCallbackInfo itself must not be
+// used after the callback returns.
+func WithScopedCallbackArgs() IsolateOption {
+	return func(config *isolateConfig) {
+		config.scopedCallbackArgs = true
+	}
+}
+
+// WithCompileCache makes Context.RunScript keep the scripts it compiles, keyed
+// by source and origin, so running the same source again in any context of
+// the isolate skips parsing and compilation. The least recently used scripts
+// are evicted beyond maxEntries, or once their sources add up to more than
+// maxBytes; a maxBytes of zero means no byte limit. See
+// Isolate.CompileCacheStats.
+func WithCompileCache(maxEntries, maxBytes int) IsolateOption {
+	return func(config *isolateConfig) {
+		config.compileCache = &compileCacheConfig{maxEntries: maxEntries, maxBytes: maxBytes}
+	}
+}
+
 // NewIsolate creates a new V8 isolate with the provided options.
 // Only one thread may access a given isolate at a time, but different
 // threads may access different isolates simultaneously.
@@ -90,8 +162,13 @@ func NewIsolate(opts ...IsolateOption) *Isolate {
 	}
 
 	iso := &Isolate{
-		ptr: C.NewIsolate(cConstraints),
-		cbs: make(map[int]FunctionCallbackWithError),
+		autoRelease:        config.autoRelease,
+		scopedCallbackArgs: config.scopedCallbackArgs,
+	}
+	iso.handle = cgo.NewHandle(iso)
+	iso.ptr = C.NewIsolate(cConstraints, C.uintptr_t(iso.handle))
+	if cc := config.compileCache; cc != nil {
+		C.IsolateEnableCompileCache(iso.ptr, C.size_t(cc.maxEntries), C.size_t(cc.maxBytes))
 	}
 	iso.null = newValueNull(iso)
 	iso.undefined = newValueUndefined(iso)
@@ -120,17 +197,46 @@ type CompileOptions struct {
 // CompileUnboundScript will create an UnboundScript (i.e. context-indepdent)
 // using the provided source JavaScript, origin (a.k.a. filename), and options.
 // If options contain a non-null CachedData, compilation of the script will use
-// that code cache.
+// that code cache. Otherwise, if EnableSharedCodeCache was called and no Mode
+// is set, the process-wide code cache is used.
 // error will be of type `JSError` if not nil.
 func (i *Isolate) CompileUnboundScript(
 	source, origin string,
 	opts CompileOptions,
 ) (*UnboundScript, error) {
-	cSource := C.CString(source)
-	cOrigin := C.CString(origin)
-	defer C.free(unsafe.Pointer(cSource))
-	defer C.free(unsafe.Pointer(cOrigin))
+	if opts.CachedData == nil && opts.Mode == CompileModeDefault {
+		if c := sharedCodeCacheInUse.Load(); c != nil {
+			return c.compile(i, source, origin)
+		}
+	}
+	return i.compileUnboundScript(source, origin, opts)
+}
+
+func (i *Isolate) compileUnboundScript(source, origin string, opts CompileOptions) (*UnboundScript, error) {
+	cSource, sourceLen := cStringN(source)
+	cOrigin, originLen := cStringN(origin)
+
+	rtn := C.IsolateCompileUnboundScript(i.ptr, cSource, sourceLen, cOrigin, originLen, opts.toC())
+	return i.unboundScriptResult(rtn, opts)
+}
+
+// CompileUnboundScriptSource is like CompileUnboundScript, but compiles a
+// ScriptSource, which V8 reads in place.
+func (i *Isolate) CompileUnboundScriptSource(
+	source *ScriptSource,
+	origin string,
+	opts CompileOptions,
+) (*UnboundScript, error) {
+	cOrigin, originLen := cStringN(origin)
+
+	src := source.retain()
+	defer C.ScriptSourceRelease(src)
+
+	rtn := C.IsolateCompileUnboundScriptSource(i.ptr, src, cOrigin, originLen, opts.toC())
+	return i.unboundScriptResult(rtn, opts)
+}
 
+func (opts CompileOptions) toC() C.CompileOptions {
 	var cOptions C.CompileOptions
 	if opts.CachedData != nil {
 		if opts.Mode != 0 {
@@ -144,8 +250,10 @@ func (i *Isolate) CompileUnboundScript(
 	} else {
 		cOptions.compileOption = C.int(opts.Mode)
 	}
+	return cOptions
+}
 
-	rtn := C.IsolateCompileUnboundScript(i.ptr, cSource, cOrigin, cOptions)
+func (i *Isolate) unboundScriptResult(rtn C.RtnUnboundScript, opts CompileOptions) (*UnboundScript, error) {
 	if rtn.ptr == nil {
 		return nil, newJSError(rtn.error)
 	}
@@ -158,6 +266,39 @@ func (i *Isolate) CompileUnboundScript(
 	}, nil
 }
 
+// CompileCacheStats describes the use of an isolate's compile cache.
+type CompileCacheStats struct {
+	Hits      uint64
+	Misses    uint64
+	Evictions uint64
+	// Entries and Bytes are the number of cached scripts, and the size of
+	// their sources and origins.
+	Entries int
+	Bytes   int
+}
+
+// CompileCacheStats returns the counters of the cache enabled by
+// WithCompileCache. They are all zero if the cache isn't enabled.
+func (i *Isolate) CompileCacheStats() CompileCacheStats {
+	s := C.IsolateGetCompileCacheStats(i.ptr)
+	return CompileCacheStats{
+		Hits:      uint64(s.hits),
+		Misses:    uint64(s.misses),
+		Evictions: uint64(s.evictions),
+		Entries:   int(s.entries),
+		Bytes:     int(s.bytes),
+	}
+}
+
+// LowMemoryNotification tells V8 that the system is running low on memory.
+// V8 responds by running a full garbage collection. Functions and templates
+// are only collected once Go has finalized their templates, so a
+// runtime.GC() should come first if the aim is to free Go callbacks.
+func (i *Isolate) LowMemoryNotification() {
+	i.releaseTemplates()
+	C.IsolateLowMemoryNotification(i.ptr)
+}
+
 // GetHeapStatistics returns heap statistics for an isolate.
 func (i *Isolate) GetHeapStatistics() HeapStatistics {
 	hs := C.IsolationGetHeapStatistics(i.ptr)
@@ -177,13 +318,68 @@ func (i *Isolate) GetHeapStatistics() HeapStatistics {
 	}
 }
 
+// Enter starts a session in which the calling goroutine keeps the isolate
+// locked and entered. It locks the goroutine to its OS thread, since V8 locks
+// are held by threads. Calls made into the isolate before the matching Exit
+// still lock and enter it, but V8 locks are recursive: a thread that already
+// holds the lock takes it again without contending with other threads, so
+// sequences of many short calls are cheaper. The session also keeps other
+// goroutines from interleaving their calls.
+//
+// Enter and Exit calls may be nested, and each Exit must be made from the
+// goroutine that called the matching Enter. If another goroutine has a
+// session open, Enter blocks until it has ended. While a session is open,
+// other goroutines block when using the isolate, or any of its contexts and
+// values.
+func (i *Isolate) Enter() {
+	if i.ptr == nil {
+		panic("Isolate has been disposed")
+	}
+	runtime.LockOSThread()
+	session := C.IsolateEnter(i.ptr)
+	i.sessionsMu.Lock()
+	i.sessions = append(i.sessions, session)
+	i.sessionsMu.Unlock()
+}
+
+// Exit ends a session started by Enter. It panics if the calling goroutine
+// has no session open.
+func (i *Isolate) Exit() {
+	i.sessionsMu.Lock()
+	n := len(i.sessions)
+	// Only the thread holding the lock can have sessions open, so this also
+	// catches an Exit from another goroutine.
+	if n == 0 || C.IsolateIsLockedByCurrentThread(i.ptr) == 0 {
+		i.sessionsMu.Unlock()
+		panic("v8go: Isolate.Exit called without Enter")
+	}
+	session := i.sessions[n-1]
+	i.sessions = i.sessions[:n-1]
+	i.sessionsMu.Unlock()
+
+	C.IsolateExit(session)
+	runtime.UnlockOSThread()
+}
+
 // Dispose will dispose the Isolate VM; subsequent calls will panic.
+// It must not be called between Enter and Exit.
 func (i *Isolate) Dispose() {
 	if i.ptr == nil {
 		return
 	}
+	i.sessionsMu.Lock()
+	open := len(i.sessions) > 0
+	i.sessionsMu.Unlock()
+	if open {
+		panic("v8go: Isolate.Dispose called while the isolate is entered")
+	}
+	i.releaseTemplates()
+	i.disposed.Store(true)
+	// Templates finalized since the last call only need their wrappers freed.
+	i.releaseTemplates()
 	C.IsolateDispose(i.ptr)
 	i.ptr = nil
+	i.handle.Delete()
 }
 
 // ThrowException schedules an exception to be thrown when returning to
@@ -194,9 +390,9 @@ func (i *Isolate) ThrowException(value *Value) *Value {
 	if i.ptr == nil {
 		panic("Isolate has been disposed")
 	}
-	return &Value{
-		ptr: C.IsolateThrowException(i.ptr, value.ptr),
-	}
+	ptr := C.IsolateThrowException(i.ptr, value.ptr)
+	runtime.KeepAlive(value)
+	return &Value{ptr: ptr}
 }
 
 // Deprecated: use `iso.Dispose()`.
@@ -209,16 +405,21 @@ func (i *Isolate) apply(opts *contextOptions) {
 }
 
 func (i *Isolate) registerCallback(cb FunctionCallbackWithError) int {
-	i.cbMutex.Lock()
-	i.cbSeq++
-	ref := i.cbSeq
-	i.cbs[ref] = cb
-	i.cbMutex.Unlock()
-	return ref
+	return i.cbs.add(&cb)
 }
 
 func (i *Isolate) getCallback(ref int) FunctionCallbackWithError {
-	i.cbMutex.RLock()
-	defer i.cbMutex.RUnlock()
-	return i.cbs[ref]
+	if cb := i.cbs.get(ref); cb != nil {
+		return *cb
+	}
+	return nil
+}
+
+func (i *Isolate) getContext(ref int) *Context {
+	return i.ctxs.get(ref)
+}
+
+// isolateFromHandle returns the isolate stored in a V8 isolate's data slot 1.
+func isolateFromHandle(handle C.uintptr_t) *Isolate {
+	return cgo.Handle(handle).Value().(*Isolate)
 }
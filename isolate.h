@@ -1,6 +1,9 @@
 #ifndef V8GO_ISOLATE_H
 #define V8GO_ISOLATE_H
 
+#include <stdint.h>
+
+#include "script_source.h"
 #include "unbound_script.h"
 
 #ifdef __cplusplus
@@ -17,6 +20,9 @@ typedef struct v8Isolate v8Isolate;
 
 typedef v8Isolate* IsolatePtr;
 
+typedef struct m_isolateSession m_isolateSession;
+typedef m_isolateSession* IsolateSessionPtr;
+
 typedef struct m_value m_value;
 typedef m_value* ValuePtr;
 
@@ -50,9 +56,14 @@ typedef struct {
 } IsolateConstraints;
 typedef IsolateConstraints* IsolateConstraintsPtr;
 
-extern IsolatePtr NewIsolate(IsolateConstraintsPtr constraints);
+extern IsolatePtr NewIsolate(IsolateConstraintsPtr constraints,
+                             uintptr_t handle);
 extern void IsolatePerformMicrotaskCheckpoint(IsolatePtr ptr);
+extern void IsolateLowMemoryNotification(IsolatePtr ptr);
 extern void IsolateDispose(IsolatePtr ptr);
+extern IsolateSessionPtr IsolateEnter(IsolatePtr ptr);
+extern void IsolateExit(IsolateSessionPtr session);
+extern int IsolateIsLockedByCurrentThread(IsolatePtr ptr);
 extern void IsolateTerminateExecution(IsolatePtr ptr);
 extern int IsolateIsExecutionTerminating(IsolatePtr ptr);
 extern IsolateHStatistics IsolationGetHeapStatistics(IsolatePtr ptr);
@@ -61,8 +72,16 @@ extern ValuePtr IsolateThrowException(IsolatePtr iso, ValuePtr value);
 
 extern RtnUnboundScript IsolateCompileUnboundScript(IsolatePtr iso_ptr,
                                                     const char* source,
+                                                    int source_len,
                                                     const char* origin,
+                                                    int origin_len,
                                                     CompileOptions options);
+extern RtnUnboundScript IsolateCompileUnboundScriptSource(
+    IsolatePtr iso_ptr,
+    ScriptSourcePtr source,
+    const char* origin,
+    int origin_len,
+    CompileOptions options);
 
 #ifdef __cplusplus
 }  // extern "C"
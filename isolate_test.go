@@ -10,6 +10,7 @@ import (
 	"math/rand"
 	"strings"
 	"testing"
+	"time"
 
 	v8 "github.com/tommie/v8go"
 )
@@ -199,6 +200,68 @@ func TestIsolateDispose(t *testing.T) {
 	}
 }
 
+func TestIsolateEnter(t *testing.T) {
+	t.Parallel()
+
+	iso := v8.NewIsolate()
+	defer iso.Dispose()
+	ctx := v8.NewContext(iso)
+	defer ctx.Close()
+
+	iso.Enter()
+	iso.Enter()
+	val, err := ctx.RunScript("1 + 1", "")
+	fatalIf(t, err)
+	iso.Exit()
+	if s := val.String(); s != "2" {
+		t.Errorf("expected 2, got %q", s)
+	}
+	iso.Exit()
+
+	if recoverPanic(func() { iso.Exit() }) == nil {
+		t.Error("expected panic on unbalanced Exit")
+	}
+}
+
+func TestIsolateEnterConcurrent(t *testing.T) {
+	t.Parallel()
+
+	iso := v8.NewIsolate()
+	defer iso.Dispose()
+	ctx := v8.NewContext(iso)
+	defer ctx.Close()
+
+	iso.Enter()
+
+	// Another goroutine can't end this session, and waits for it to end
+	// before opening its own.
+	done := make(chan interface{})
+	entered := make(chan struct{})
+	go func() {
+		done <- recoverPanic(func() { iso.Exit() })
+		iso.Enter()
+		close(entered)
+		_, err := ctx.RunScript("2", "")
+		iso.Exit()
+		done <- err
+	}()
+	if <-done == nil {
+		t.Error("expected panic on Exit from another goroutine")
+	}
+	select {
+	case <-entered:
+		t.Error("expected Enter to wait for the open session")
+	case <-time.After(50 * time.Millisecond):
+	}
+	_, err := ctx.RunScript("1", "")
+	fatalIf(t, err)
+	iso.Exit()
+
+	if err := <-done; err != nil {
+		t.Errorf("unexpected error in second session: %v", err)
+	}
+}
+
 func TestIsolateThrowException(t *testing.T) {
 	t.Parallel()
 	iso := v8.NewIsolate()
@@ -263,6 +326,34 @@ func BenchmarkIsolateInitialization(b *testing.B) {
 	}
 }
 
+func BenchmarkIsolateEnter(b *testing.B) {
+	iso := v8.NewIsolate()
+	defer iso.Dispose()
+	ctx := v8.NewContext(iso)
+	defer ctx.Close()
+	obj, err := ctx.RunScript("({a: 'hello'})", "")
+	if err != nil {
+		b.Fatal(err)
+	}
+	o, _ := obj.AsObject()
+
+	run := func(b *testing.B) {
+		b.ReportAllocs()
+		for n := 0; n < b.N; n++ {
+			s, err := o.GetString("a")
+			if err != nil || s != "hello" {
+				b.Fatalf("unexpected result %q, %v", s, err)
+			}
+		}
+	}
+	b.Run("Unentered", run)
+	b.Run("Entered", func(b *testing.B) {
+		iso.Enter()
+		defer iso.Exit()
+		run(b)
+	})
+}
+
 func BenchmarkIsolateInitAndRun(b *testing.B) {
 	b.ReportAllocs()
 	for n := 0; n < b.N; n++ {
@@ -332,3 +423,42 @@ func TestNewIsolateWithConstraints(t *testing.T) {
 		t.Fatalf("Memory test completed unexpectedly: %v", val)
 	}
 }
+
+func TestIsolateCompileCache(t *testing.T) {
+	t.Parallel()
+
+	iso := v8.NewIsolate(v8.WithCompileCache(2, 0))
+	defer iso.Dispose()
+
+	for i := 0; i < 3; i++ {
+		ctx := v8.NewContext(iso)
+		val, err := ctx.RunScript(`let x = 40; x + 2`, "cached.js")
+		fatalIf(t, err)
+		if val.Int32() != 42 {
+			t.Errorf("expected 42, got %v", val)
+		}
+		ctx.Close()
+	}
+	if s := iso.CompileCacheStats(); s.Hits != 2 || s.Misses != 1 || s.Entries != 1 {
+		t.Errorf("unexpected stats after repeated runs: %+v", s)
+	}
+
+	ctx := v8.NewContext(iso)
+	defer ctx.Close()
+	if _, err := ctx.RunScript(`(`, "broken.js"); err == nil {
+		t.Error("expected a syntax error")
+	}
+	for _, source := range []string{`1`, `2`, `3`} {
+		_, err := ctx.RunScript(source, "")
+		fatalIf(t, err)
+	}
+	if s := iso.CompileCacheStats(); s.Entries != 2 || s.Evictions != 2 || s.Bytes != 2 {
+		t.Errorf("unexpected stats after eviction: %+v", s)
+	}
+
+	plain := v8.NewIsolate()
+	defer plain.Dispose()
+	if s := plain.CompileCacheStats(); s != (v8.CompileCacheStats{}) {
+		t.Errorf("expected no stats without a cache, got %+v", s)
+	}
+}
@@ -9,6 +9,8 @@ package v8go
 import "C"
 import (
 	"errors"
+	"io"
+	"runtime"
 	"unsafe"
 )
 
@@ -18,10 +20,8 @@ func JSONParse(ctx *Context, str string) (*Value, error) {
 	if ctx == nil {
 		return nil, errors.New("v8go: Context is required")
 	}
-	cstr := C.CString(str)
-	defer C.free(unsafe.Pointer(cstr))
-
-	rtn := C.JSONParse(ctx.ptr, cstr)
+	cstr, n := cStringN(str)
+	rtn := C.JSONParse(ctx.ptr, cstr, n)
 	return valueResult(ctx, rtn)
 }
 
@@ -37,6 +37,31 @@ func JSONStringify(ctx *Context, val Valuer) (string, error) {
 	}
 
 	str := C.JSONStringify(ctxPtr, val.value().ptr)
+	runtime.KeepAlive(val)
 	defer C.free(unsafe.Pointer(str))
 	return C.GoString(str), nil
 }
+
+// JSONStringifyTo is like JSONStringify, but writes the JSON to w in chunks, so
+// memory use doesn't grow with the size of the result. A nil ctx defaults to
+// the context of val. Any JS errors will be returned as `JSError`.
+func JSONStringifyTo(ctx *Context, val Valuer, w io.Writer) (int64, error) {
+	if val == nil || val.value() == nil {
+		return 0, errors.New("v8go: Value is required")
+	}
+	if ctx == nil {
+		ctx = val.value().ctx
+	}
+	if ctx == nil {
+		return 0, errors.New("v8go: Context is required")
+	}
+
+	rtn := C.JSONStringifyValue(ctx.ptr, val.value().ptr)
+	runtime.KeepAlive(val)
+	str, err := valueResult(ctx, rtn)
+	if err != nil {
+		return 0, err
+	}
+	defer str.Release()
+	return str.WriteStringTo(w)
+}
@@ -11,8 +11,11 @@ extern "C" {
 typedef struct m_ctx m_ctx;
 typedef m_ctx* ContextPtr;
 
-extern RtnValue JSONParse(ContextPtr ctx_ptr, const char* str);
+extern RtnValue JSONParse(ContextPtr ctx_ptr, const char* str, int len);
 const char* JSONStringify(ContextPtr ctx_ptr, ValuePtr val_ptr);
+// JSONStringifyValue is like JSONStringify, but returns the JSON as a string
+// value of the context, which can then be read in chunks.
+extern RtnValue JSONStringifyValue(ContextPtr ctx_ptr, ValuePtr val_ptr);
 
 #ifdef __cplusplus
 }
@@ -6,6 +6,7 @@ package v8go_test
 
 import (
 	"fmt"
+	"strings"
 	"testing"
 
 	v8 "github.com/tommie/v8go"
@@ -42,6 +43,32 @@ func TestJSONStringify(t *testing.T) {
 	}
 }
 
+func TestJSONStringifyTo(t *testing.T) {
+	t.Parallel()
+
+	ctx := v8.NewContext()
+	defer ctx.Isolate().Dispose()
+	defer ctx.Close()
+
+	val, err := ctx.RunScript(`({ list: Array(20000).fill("é😀") })`, "")
+	fatalIf(t, err)
+	want, err := v8.JSONStringify(ctx, val)
+	fatalIf(t, err)
+
+	var sb strings.Builder
+	n, err := v8.JSONStringifyTo(nil, val, &sb)
+	fatalIf(t, err)
+	if n != int64(len(want)) || sb.String() != want {
+		t.Errorf("expected %d bytes of JSON, got %d", len(want), n)
+	}
+
+	cyclic, err := ctx.RunScript(`const o = {}; o.o = o; o`, "")
+	fatalIf(t, err)
+	if _, err := v8.JSONStringifyTo(ctx, cyclic, &sb); err == nil {
+		t.Error("expected an error for a cyclic object")
+	}
+}
+
 func ExampleJSONParse() {
 	ctx := v8.NewContext()
 	defer ctx.Isolate().Dispose()
@@ -0,0 +1,23 @@
+#include "key.h"
+
+#include "context.h"
+#include "deps/include/v8-primitive.h"
+#include "isolate-macros.h"
+
+using namespace v8;
+
+KeyPtr NewKey(IsolatePtr iso, const char* name, int name_len) {
+  ISOLATE_SCOPE(iso);
+  INTERNAL_CONTEXT(iso);
+
+  Local<String> str;
+  if (!String::NewFromUtf8(iso, name, NewStringType::kInternalized, name_len)
+           .ToLocal(&str)) {
+    return nullptr;
+  }
+  // Keys are never freed individually; the internal context's slab releases
+  // them all when the isolate is disposed.
+  m_key* key = ctx->keySlab.New();
+  key->handle.Set(iso, str);
+  return key;
+}
@@ -0,0 +1,49 @@
+package v8go
+
+// #include "key.h"
+import "C"
+import "fmt"
+
+// Key is an internalized property name of an isolate. Reading or writing a
+// property through a Key skips creating and hashing the name string, which
+// makes it the fastest way to access the same properties repeatedly. Keys
+// live as long as their isolate, so they should be used for a bounded set of
+// names, not arbitrary input.
+type Key struct {
+	ptr  C.KeyPtr
+	iso  *Isolate
+	name string
+}
+
+// Key returns the key for a property name. Keys are cached, so every call with
+// the same name returns the same Key.
+func (i *Isolate) Key(name string) *Key {
+	i.keysMu.Lock()
+	defer i.keysMu.Unlock()
+
+	if k := i.keys[name]; k != nil {
+		return k
+	}
+	cName, nameLen := cStringN(name)
+	ptr := C.NewKey(i.ptr, cName, nameLen)
+	if ptr == nil {
+		panic(fmt.Sprintf("v8go: failed to create key %q", name))
+	}
+	k := &Key{ptr: ptr, iso: i, name: name}
+	if i.keys == nil {
+		i.keys = make(map[string]*Key)
+	}
+	i.keys[name] = k
+	return k
+}
+
+// String returns the property name.
+func (k *Key) String() string {
+	return k.name
+}
+
+func (k *Key) check(iso *Isolate) {
+	if k.iso != iso {
+		panic(fmt.Sprintf("v8go: key %q belongs to another isolate", k.name))
+	}
+}
@@ -0,0 +1,33 @@
+#ifndef V8GO_KEY_H
+#define V8GO_KEY_H
+
+#ifdef __cplusplus
+
+#include "deps/include/v8-persistent-handle.h"
+
+namespace v8 {
+class Isolate;
+class String;
+}  // namespace v8
+typedef v8::Isolate v8Isolate;
+
+// m_key is an internalized property name that lives as long as its isolate.
+struct m_key {
+  v8::Eternal<v8::String> handle;
+};
+
+extern "C" {
+#else
+typedef struct v8Isolate v8Isolate;
+#endif
+typedef v8Isolate* IsolatePtr;
+
+typedef struct m_key m_key;
+typedef m_key* KeyPtr;
+
+extern KeyPtr NewKey(IsolatePtr iso_ptr, const char* name, int name_len);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -1,6 +1,7 @@
 #include "object.h"
 #include "deps/include/v8-object.h"
 #include "isolate-macros.h"
+#include "key.h"
 #include "utils.h"
 #include "value-macros.h"
 #include "value.h"
@@ -13,13 +14,25 @@ using namespace v8;
   LOCAL_VALUE(ptr)        \
   Local<Object> obj = value.As<Object>()
 
-void ObjectSet(ValuePtr ptr, const char* key, ValuePtr prop_val) {
+// newKey creates a property key from a UTF-8 string with the given length.
+static MaybeLocal<String> newKey(Isolate* iso, const char* key, int key_len) {
+  return String::NewFromUtf8(iso, key, NewStringType::kInternalized, key_len);
+}
+
+void ObjectSet(ValuePtr ptr,
+               const char* key,
+               int key_len,
+               ValuePtr prop_val) {
   LOCAL_OBJECT(ptr);
-  Local<String> key_val =
-      String::NewFromUtf8(iso, key, NewStringType::kNormal).ToLocalChecked();
+  Local<String> key_val = newKey(iso, key, key_len).ToLocalChecked();
   obj->Set(local_ctx, key_val, prop_val->ptr.Get(iso)).Check();
 }
 
+void ObjectSetKey(ValuePtr ptr, KeyPtr key, ValuePtr prop_val) {
+  LOCAL_OBJECT(ptr);
+  obj->Set(local_ctx, key->handle.Get(iso), prop_val->ptr.Get(iso)).Check();
+}
+
 void ObjectSetAnyKey(ValuePtr ptr, ValuePtr key, ValuePtr prop_val) {
   LOCAL_OBJECT(ptr);
   Local<Value> local_key = key->ptr.Get(iso);
@@ -49,13 +62,44 @@ int ObjectInternalFieldCount(ValuePtr ptr) {
   return obj->InternalFieldCount();
 }
 
-RtnValue ObjectGet(ValuePtr ptr, const char* key) {
+int ObjectSetAlignedPointerInInternalField(ValuePtr ptr,
+                                           int idx,
+                                           uintptr_t v) {
+  Isolate* iso = ptr->iso;
+  Locker locker(iso);
+  HandleScope handle_scope(iso);
+  Local<Object> obj = ptr->ptr.Get(iso).As<Object>();
+
+  if (idx >= obj->InternalFieldCount()) {
+    return 0;
+  }
+  obj->SetAlignedPointerInInternalField(idx, encodeFieldPointer(v));
+  return 1;
+}
+
+int ObjectGetAlignedPointerFromInternalField(ValuePtr ptr,
+                                             int idx,
+                                             uintptr_t* v) {
+  // No context or value is needed to read the field, so this skips
+  // LOCAL_OBJECT.
+  Isolate* iso = ptr->iso;
+  Locker locker(iso);
+  HandleScope handle_scope(iso);
+  Local<Object> obj = ptr->ptr.Get(iso).As<Object>();
+
+  if (idx >= obj->InternalFieldCount()) {
+    return 0;
+  }
+  *v = decodeFieldPointer(obj->GetAlignedPointerFromInternalField(idx));
+  return 1;
+}
+
+RtnValue ObjectGet(ValuePtr ptr, const char* key, int key_len) {
   LOCAL_OBJECT(ptr);
   RtnValue rtn = {};
 
   Local<String> key_val;
-  if (!String::NewFromUtf8(iso, key, NewStringType::kNormal)
-           .ToLocal(&key_val)) {
+  if (!newKey(iso, key, key_len).ToLocal(&key_val)) {
     rtn.error = ExceptionError(try_catch, iso, local_ctx);
     return rtn;
   }
@@ -64,13 +108,20 @@ RtnValue ObjectGet(ValuePtr ptr, const char* key) {
     rtn.error = ExceptionError(try_catch, iso, local_ctx);
     return rtn;
   }
-  m_value* new_val = new m_value;
-  new_val->id = 0;
-  new_val->iso = iso;
-  new_val->ctx = ctx;
-  new_val->ptr = Global<Value>(iso, result);
+  rtn.value = tracked_value(ctx, result);
+  return rtn;
+}
 
-  rtn.value = tracked_value(ctx, new_val);
+RtnValue ObjectGetKey(ValuePtr ptr, KeyPtr key) {
+  LOCAL_OBJECT(ptr);
+  RtnValue rtn = {};
+
+  Local<Value> result;
+  if (!obj->Get(local_ctx, key->handle.Get(iso)).ToLocal(&result)) {
+    rtn.error = ExceptionError(try_catch, iso, local_ctx);
+    return rtn;
+  }
+  rtn.value = tracked_value(ctx, result);
   return rtn;
 }
 
@@ -84,13 +135,7 @@ RtnValue ObjectGetAnyKey(ValuePtr ptr, ValuePtr key) {
     rtn.error = ExceptionError(try_catch, iso, local_ctx);
     return rtn;
   }
-  m_value* new_val = new m_value;
-  new_val->id = 0;
-  new_val->iso = iso;
-  new_val->ctx = ctx;
-  new_val->ptr = Global<Value>(iso, result);
-
-  rtn.value = tracked_value(ctx, new_val);
+  rtn.value = tracked_value(ctx, result);
   return rtn;
 }
 
@@ -109,13 +154,7 @@ RtnValue ObjectGetInternalField(ValuePtr ptr, int idx) {
     return rtn;
   }
 
-  m_value* new_val = new m_value;
-  new_val->id = 0;
-  new_val->iso = iso;
-  new_val->ctx = ctx;
-  new_val->ptr = Global<Value>(iso, result.As<Value>());
-
-  rtn.value = tracked_value(ctx, new_val);
+  rtn.value = tracked_value(ctx, result.As<Value>());
   return rtn;
 }
 
@@ -128,23 +167,111 @@ RtnValue ObjectGetIdx(ValuePtr ptr, uint32_t idx) {
     rtn.error = ExceptionError(try_catch, iso, local_ctx);
     return rtn;
   }
-  m_value* new_val = new m_value;
-  new_val->id = 0;
-  new_val->iso = iso;
-  new_val->ctx = ctx;
-  new_val->ptr = Global<Value>(iso, result);
+  rtn.value = tracked_value(ctx, result);
+  return rtn;
+}
+
+// The typed getters below read a property and return it as a C primitive,
+// without allocating a tracked value for the result.
+
+static MaybeLocal<Value> getNamedProperty(Isolate* iso,
+                                          Local<Context> local_ctx,
+                                          Local<Object> obj,
+                                          const char* key,
+                                          int key_len) {
+  Local<String> key_val;
+  if (!newKey(iso, key, key_len).ToLocal(&key_val)) {
+    return MaybeLocal<Value>();
+  }
+  return obj->Get(local_ctx, key_val);
+}
+
+RtnInt32 ObjectGetInt32(ValuePtr ptr, const char* key, int key_len) {
+  LOCAL_OBJECT(ptr);
+  RtnInt32 rtn = {};
+
+  Local<Value> result;
+  if (!getNamedProperty(iso, local_ctx, obj, key, key_len).ToLocal(&result)) {
+    rtn.status = TYPED_GET_EXCEPTION;
+    rtn.error = ExceptionError(try_catch, iso, local_ctx);
+    return rtn;
+  }
+  if (!result->IsInt32()) {
+    rtn.status = TYPED_GET_TYPE_MISMATCH;
+    return rtn;
+  }
+  rtn.value = result.As<Int32>()->Value();
+  return rtn;
+}
+
+RtnFloat64 ObjectGetFloat64(ValuePtr ptr, const char* key, int key_len) {
+  LOCAL_OBJECT(ptr);
+  RtnFloat64 rtn = {};
+
+  Local<Value> result;
+  if (!getNamedProperty(iso, local_ctx, obj, key, key_len).ToLocal(&result)) {
+    rtn.status = TYPED_GET_EXCEPTION;
+    rtn.error = ExceptionError(try_catch, iso, local_ctx);
+    return rtn;
+  }
+  if (!result->IsNumber()) {
+    rtn.status = TYPED_GET_TYPE_MISMATCH;
+    return rtn;
+  }
+  rtn.value = result.As<Number>()->Value();
+  return rtn;
+}
+
+RtnBool ObjectGetBool(ValuePtr ptr, const char* key, int key_len) {
+  LOCAL_OBJECT(ptr);
+  RtnBool rtn = {};
+
+  Local<Value> result;
+  if (!getNamedProperty(iso, local_ctx, obj, key, key_len).ToLocal(&result)) {
+    rtn.status = TYPED_GET_EXCEPTION;
+    rtn.error = ExceptionError(try_catch, iso, local_ctx);
+    return rtn;
+  }
+  if (!result->IsBoolean()) {
+    rtn.status = TYPED_GET_TYPE_MISMATCH;
+    return rtn;
+  }
+  rtn.value = result.As<Boolean>()->Value();
+  return rtn;
+}
+
+RtnTypedString ObjectGetString(ValuePtr ptr, const char* key, int key_len) {
+  LOCAL_OBJECT(ptr);
+  RtnTypedString rtn = {};
 
-  rtn.value = tracked_value(ctx, new_val);
+  Local<Value> result;
+  if (!getNamedProperty(iso, local_ctx, obj, key, key_len).ToLocal(&result)) {
+    rtn.status = TYPED_GET_EXCEPTION;
+    rtn.error = ExceptionError(try_catch, iso, local_ctx);
+    return rtn;
+  }
+  if (!result->IsString()) {
+    rtn.status = TYPED_GET_TYPE_MISMATCH;
+    return rtn;
+  }
+  Local<String> str = result.As<String>();
+  rtn.length = str->Utf8LengthV2(iso);
+  rtn.data = static_cast<char*>(malloc(rtn.length));
+  str->WriteUtf8V2(iso, rtn.data, rtn.length);
   return rtn;
 }
 
-int ObjectHas(ValuePtr ptr, const char* key) {
+int ObjectHas(ValuePtr ptr, const char* key, int key_len) {
   LOCAL_OBJECT(ptr);
-  Local<String> key_val =
-      String::NewFromUtf8(iso, key, NewStringType::kNormal).ToLocalChecked();
+  Local<String> key_val = newKey(iso, key, key_len).ToLocalChecked();
   return obj->Has(local_ctx, key_val).ToChecked();
 }
 
+int ObjectHasKey(ValuePtr ptr, KeyPtr key) {
+  LOCAL_OBJECT(ptr);
+  return obj->Has(local_ctx, key->handle.Get(iso)).ToChecked();
+}
+
 int ObjectHasAnyKey(ValuePtr ptr, ValuePtr key) {
   LOCAL_OBJECT(ptr);
   Local<Value> local_key = key->ptr.Get(iso);
@@ -156,13 +283,17 @@ int ObjectHasIdx(ValuePtr ptr, uint32_t idx) {
   return obj->Has(local_ctx, idx).ToChecked();
 }
 
-int ObjectDelete(ValuePtr ptr, const char* key) {
+int ObjectDelete(ValuePtr ptr, const char* key, int key_len) {
   LOCAL_OBJECT(ptr);
-  Local<String> key_val =
-      String::NewFromUtf8(iso, key, NewStringType::kNormal).ToLocalChecked();
+  Local<String> key_val = newKey(iso, key, key_len).ToLocalChecked();
   return obj->Delete(local_ctx, key_val).ToChecked();
 }
 
+int ObjectDeleteKey(ValuePtr ptr, KeyPtr key) {
+  LOCAL_OBJECT(ptr);
+  return obj->Delete(local_ctx, key->handle.Get(iso)).ToChecked();
+}
+
 int ObjectDeleteAnyKey(ValuePtr ptr, ValuePtr key) {
   LOCAL_OBJECT(ptr);
   Local<Value> local_key = key->ptr.Get(iso);
@@ -10,6 +10,7 @@ import "C"
 import (
 	"fmt"
 	"math/big"
+	"runtime"
 	"unsafe"
 )
 
@@ -19,10 +20,10 @@ type Object struct {
 }
 
 func (o *Object) MethodCall(methodName string, args ...Valuer) (*Value, error) {
-	ckey := C.CString(methodName)
-	defer C.free(unsafe.Pointer(ckey))
+	ckey, keyLen := cStringN(methodName)
 
-	getRtn := C.ObjectGet(o.ptr, ckey)
+	getRtn := C.ObjectGet(o.ptr, ckey, keyLen)
+	runtime.KeepAlive(o)
 	prop, err := valueResult(o.ctx, getRtn)
 	if err != nil {
 		return nil, err
@@ -58,9 +59,24 @@ func (o *Object) Set(key string, val interface{}) error {
 		return err
 	}
 
-	ckey := C.CString(key)
-	defer C.free(unsafe.Pointer(ckey))
-	C.ObjectSet(o.ptr, ckey, value.ptr)
+	ckey, keyLen := cStringN(key)
+	C.ObjectSet(o.ptr, ckey, keyLen, value.ptr)
+	runtime.KeepAlive(o)
+	runtime.KeepAlive(value)
+	return nil
+}
+
+// SetKey is like Set, but takes a Key of the object's isolate.
+func (o *Object) SetKey(key *Key, val interface{}) error {
+	key.check(o.ctx.iso)
+	value, err := coerceValue(o.ctx.iso, val)
+	if err != nil {
+		return err
+	}
+
+	C.ObjectSetKey(o.ptr, key.ptr, value.ptr)
+	runtime.KeepAlive(o)
+	runtime.KeepAlive(value)
 	return nil
 }
 
@@ -75,6 +91,9 @@ func (o *Object) SetSymbol(key *Symbol, val interface{}) error {
 	}
 
 	C.ObjectSetAnyKey(o.ptr, key.ptr, value.ptr)
+	runtime.KeepAlive(o)
+	runtime.KeepAlive(key)
+	runtime.KeepAlive(value)
 	return nil
 }
 
@@ -89,6 +108,8 @@ func (o *Object) SetIdx(idx uint32, val interface{}) error {
 	}
 
 	C.ObjectSetIdx(o.ptr, C.uint32_t(idx), value.ptr)
+	runtime.KeepAlive(o)
+	runtime.KeepAlive(value)
 
 	return nil
 }
@@ -103,6 +124,8 @@ func (o *Object) SetInternalField(idx uint32, val interface{}) error {
 	}
 
 	inserted := C.ObjectSetInternalField(o.ptr, C.int(idx), value.ptr)
+	runtime.KeepAlive(o)
+	runtime.KeepAlive(value)
 
 	if inserted == 0 {
 		panic(fmt.Errorf("index out of range [%v] with length %v", idx, o.InternalFieldCount()))
@@ -111,24 +134,128 @@ func (o *Object) SetInternalField(idx uint32, val interface{}) error {
 	return nil
 }
 
+// SetAlignedPointerInInternalField stores v, such as a cgo.Handle or an index
+// into a Go slice, in an internal field for an ObjectTemplate instance. Unlike
+// SetInternalField, no JS value is created, so callbacks can find the Go
+// object behind their receiver cheaply. The top bit of v is not stored.
+// Panics if the index isn't in the range set by (*ObjectTemplate).SetInternalFieldCount.
+func (o *Object) SetAlignedPointerInInternalField(idx uint32, v uintptr) {
+	ok := C.ObjectSetAlignedPointerInInternalField(o.ptr, C.int(idx), C.uintptr_t(v))
+	runtime.KeepAlive(o)
+	if ok == 0 {
+		panic(fmt.Errorf("index out of range [%v] with length %v", idx, o.InternalFieldCount()))
+	}
+}
+
+// GetAlignedPointerFromInternalField returns the value stored by
+// SetAlignedPointerInInternalField. The result is undefined if the field was
+// not set that way.
+// Panics if the index isn't in the range set by (*ObjectTemplate).SetInternalFieldCount.
+func (o *Object) GetAlignedPointerFromInternalField(idx uint32) uintptr {
+	var v C.uintptr_t
+	ok := C.ObjectGetAlignedPointerFromInternalField(o.ptr, C.int(idx), &v)
+	runtime.KeepAlive(o)
+	if ok == 0 {
+		panic(fmt.Errorf("index out of range [%v] with length %v", idx, o.InternalFieldCount()))
+	}
+	return uintptr(v)
+}
+
 // InternalFieldCount returns the number of internal fields this Object has.
 func (o *Object) InternalFieldCount() uint32 {
 	count := C.ObjectInternalFieldCount(o.ptr)
+	runtime.KeepAlive(o)
 	return uint32(count)
 }
 
 // Get tries to get a Value for a given Object property key.
 func (o *Object) Get(key string) (*Value, error) {
-	ckey := C.CString(key)
-	defer C.free(unsafe.Pointer(ckey))
+	ckey, keyLen := cStringN(key)
 
-	rtn := C.ObjectGet(o.ptr, ckey)
+	rtn := C.ObjectGet(o.ptr, ckey, keyLen)
+	runtime.KeepAlive(o)
 	return valueResult(o.ctx, rtn)
 }
 
+// GetKey is like Get, but takes a Key of the object's isolate.
+func (o *Object) GetKey(key *Key) (*Value, error) {
+	key.check(o.ctx.iso)
+	rtn := C.ObjectGetKey(o.ptr, key.ptr)
+	runtime.KeepAlive(o)
+	return valueResult(o.ctx, rtn)
+}
+
+// GetInt32 gets a property that is expected to hold a 32-bit signed integer
+// (see Value.IsInt32). Unlike Get(key).Int32(), it returns the primitive in a
+// single call without creating a Value, and returns an error instead of
+// converting a property of another type.
+func (o *Object) GetInt32(key string) (int32, error) {
+	ckey, keyLen := cStringN(key)
+
+	rtn := C.ObjectGetInt32(o.ptr, ckey, keyLen)
+	runtime.KeepAlive(o)
+	if err := typedGetError(rtn.status, rtn.error, key, "an Int32"); err != nil {
+		return 0, err
+	}
+	return int32(rtn.value), nil
+}
+
+// GetFloat64 gets a property that is expected to hold a number, without
+// creating a Value. It returns an error if the property is not a number.
+func (o *Object) GetFloat64(key string) (float64, error) {
+	ckey, keyLen := cStringN(key)
+
+	rtn := C.ObjectGetFloat64(o.ptr, ckey, keyLen)
+	runtime.KeepAlive(o)
+	if err := typedGetError(rtn.status, rtn.error, key, "a Number"); err != nil {
+		return 0, err
+	}
+	return float64(rtn.value), nil
+}
+
+// GetBool gets a property that is expected to hold a boolean, without
+// creating a Value. It returns an error if the property is not a boolean.
+func (o *Object) GetBool(key string) (bool, error) {
+	ckey, keyLen := cStringN(key)
+
+	rtn := C.ObjectGetBool(o.ptr, ckey, keyLen)
+	runtime.KeepAlive(o)
+	if err := typedGetError(rtn.status, rtn.error, key, "a Boolean"); err != nil {
+		return false, err
+	}
+	return rtn.value != 0, nil
+}
+
+// GetString gets a property that is expected to hold a string, without
+// creating a Value. It returns an error if the property is not a string.
+func (o *Object) GetString(key string) (string, error) {
+	ckey, keyLen := cStringN(key)
+
+	rtn := C.ObjectGetString(o.ptr, ckey, keyLen)
+	runtime.KeepAlive(o)
+	if err := typedGetError(rtn.status, rtn.error, key, "a String"); err != nil {
+		return "", err
+	}
+	defer C.free(unsafe.Pointer(rtn.data))
+	return C.GoStringN(rtn.data, C.int(rtn.length)), nil
+}
+
+func typedGetError(status C.TypedGetStatus, rtnErr C.RtnError, key, want string) error {
+	switch status {
+	case C.TYPED_GET_OK:
+		return nil
+	case C.TYPED_GET_TYPE_MISMATCH:
+		return fmt.Errorf("v8go: property %q is not %s", key, want)
+	default:
+		return newJSError(rtnErr)
+	}
+}
+
 // GetSymbol tries to get a Value for a given Object property key.
 func (o *Object) GetSymbol(key *Symbol) (*Value, error) {
 	rtn := C.ObjectGetAnyKey(o.ptr, key.ptr)
+	runtime.KeepAlive(o)
+	runtime.KeepAlive(key)
 	return valueResult(o.ctx, rtn)
 }
 
@@ -138,50 +265,80 @@ func (o *Object) GetSymbol(key *Symbol) (*Value, error) {
 // than a Value.
 func (o *Object) GetInternalField(idx uint32) *Value {
 	rtn := C.ObjectGetInternalField(o.ptr, C.int(idx))
+	runtime.KeepAlive(o)
 	if rtn.value == nil {
 		panic(newJSError(rtn.error))
 	}
-	return &Value{rtn.value, o.ctx}
+	return newValue(rtn.value, o.ctx)
 }
 
 // GetIdx tries to get a Value at a give Object index.
 func (o *Object) GetIdx(idx uint32) (*Value, error) {
 	rtn := C.ObjectGetIdx(o.ptr, C.uint32_t(idx))
+	runtime.KeepAlive(o)
 	return valueResult(o.ctx, rtn)
 }
 
 // Has calls the abstract operation HasProperty(O, P) described in ECMA-262, 7.3.10.
 // Returns true, if the object has the property, either own or on the prototype chain.
 func (o *Object) Has(key string) bool {
-	ckey := C.CString(key)
-	defer C.free(unsafe.Pointer(ckey))
-	return C.ObjectHas(o.ptr, ckey) != 0
+	ckey, keyLen := cStringN(key)
+	rtn := C.ObjectHas(o.ptr, ckey, keyLen) != 0
+	runtime.KeepAlive(o)
+	return rtn
+}
+
+// HasKey is like Has, but takes a Key of the object's isolate.
+func (o *Object) HasKey(key *Key) bool {
+	key.check(o.ctx.iso)
+	rtn := C.ObjectHasKey(o.ptr, key.ptr) != 0
+	runtime.KeepAlive(o)
+	return rtn
 }
 
 // HasSymbol calls the abstract operation HasProperty(O, P) described in ECMA-262, 7.3.10.
 // Returns true, if the object has the property, either own or on the prototype chain.
 func (o *Object) HasSymbol(key *Symbol) bool {
-	return C.ObjectHasAnyKey(o.ptr, key.ptr) != 0
+	rtn := C.ObjectHasAnyKey(o.ptr, key.ptr) != 0
+	runtime.KeepAlive(o)
+	runtime.KeepAlive(key)
+	return rtn
 }
 
 // HasIdx returns true if the object has a value at the given index.
 func (o *Object) HasIdx(idx uint32) bool {
-	return C.ObjectHasIdx(o.ptr, C.uint32_t(idx)) != 0
+	rtn := C.ObjectHasIdx(o.ptr, C.uint32_t(idx)) != 0
+	runtime.KeepAlive(o)
+	return rtn
 }
 
 // Delete returns true if successful in deleting a named property on the object.
 func (o *Object) Delete(key string) bool {
-	ckey := C.CString(key)
-	defer C.free(unsafe.Pointer(ckey))
-	return C.ObjectDelete(o.ptr, ckey) != 0
+	ckey, keyLen := cStringN(key)
+	rtn := C.ObjectDelete(o.ptr, ckey, keyLen) != 0
+	runtime.KeepAlive(o)
+	return rtn
+}
+
+// DeleteKey is like Delete, but takes a Key of the object's isolate.
+func (o *Object) DeleteKey(key *Key) bool {
+	key.check(o.ctx.iso)
+	rtn := C.ObjectDeleteKey(o.ptr, key.ptr) != 0
+	runtime.KeepAlive(o)
+	return rtn
 }
 
 // DeleteSymbol returns true if successful in deleting a named property on the object.
 func (o *Object) DeleteSymbol(key *Symbol) bool {
-	return C.ObjectDeleteAnyKey(o.ptr, key.ptr) != 0
+	rtn := C.ObjectDeleteAnyKey(o.ptr, key.ptr) != 0
+	runtime.KeepAlive(o)
+	runtime.KeepAlive(key)
+	return rtn
 }
 
 // DeleteIdx returns true if successful in deleting a value at a given index of the object.
 func (o *Object) DeleteIdx(idx uint32) bool {
-	return C.ObjectDeleteIdx(o.ptr, C.uint32_t(idx)) != 0
+	rtn := C.ObjectDeleteIdx(o.ptr, C.uint32_t(idx)) != 0
+	runtime.KeepAlive(o)
+	return rtn
 }
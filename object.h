@@ -4,26 +4,89 @@
 #include <stdint.h>
 
 #include "errors.h"
+#include "key.h"
 
 #ifdef __cplusplus
 
+// Aligned pointer internal fields hold a uintptr_t shifted left by one bit,
+// since V8 requires the lowest bit of the pointer to be clear.
+inline void* encodeFieldPointer(uintptr_t v) {
+  return reinterpret_cast<void*>(v << 1);
+}
+
+inline uintptr_t decodeFieldPointer(void* p) {
+  return reinterpret_cast<uintptr_t>(p) >> 1;
+}
+
 extern "C" {
 #endif
 
-extern void ObjectSet(ValuePtr ptr, const char* key, ValuePtr val_ptr);
+typedef enum {
+  TYPED_GET_OK = 0,
+  TYPED_GET_EXCEPTION,
+  TYPED_GET_TYPE_MISMATCH,
+} TypedGetStatus;
+
+typedef struct {
+  int32_t value;
+  TypedGetStatus status;
+  RtnError error;
+} RtnInt32;
+
+typedef struct {
+  double value;
+  TypedGetStatus status;
+  RtnError error;
+} RtnFloat64;
+
+typedef struct {
+  int value;
+  TypedGetStatus status;
+  RtnError error;
+} RtnBool;
+
+typedef struct {
+  char* data;
+  int length;
+  TypedGetStatus status;
+  RtnError error;
+} RtnTypedString;
+
+extern void ObjectSet(ValuePtr ptr,
+                      const char* key,
+                      int key_len,
+                      ValuePtr val_ptr);
+extern void ObjectSetKey(ValuePtr ptr, KeyPtr key, ValuePtr val_ptr);
 extern void ObjectSetAnyKey(ValuePtr ptr, ValuePtr key, ValuePtr val_ptr);
 extern void ObjectSetIdx(ValuePtr ptr, uint32_t idx, ValuePtr val_ptr);
 extern int ObjectSetInternalField(ValuePtr ptr, int idx, ValuePtr val_ptr);
 extern int ObjectInternalFieldCount(ValuePtr ptr);
+extern int ObjectSetAlignedPointerInInternalField(ValuePtr ptr,
+                                                  int idx,
+                                                  uintptr_t v);
+extern int ObjectGetAlignedPointerFromInternalField(ValuePtr ptr,
+                                                    int idx,
+                                                    uintptr_t* v);
 
-extern RtnValue ObjectGet(ValuePtr ptr, const char* key);
+extern RtnValue ObjectGet(ValuePtr ptr, const char* key, int key_len);
+extern RtnValue ObjectGetKey(ValuePtr ptr, KeyPtr key);
 extern RtnValue ObjectGetAnyKey(ValuePtr ptr, ValuePtr key);
 extern RtnValue ObjectGetIdx(ValuePtr ptr, uint32_t idx);
 extern RtnValue ObjectGetInternalField(ValuePtr ptr, int idx);
-int ObjectHas(ValuePtr ptr, const char* key);
+extern RtnInt32 ObjectGetInt32(ValuePtr ptr, const char* key, int key_len);
+extern RtnFloat64 ObjectGetFloat64(ValuePtr ptr,
+                                   const char* key,
+                                   int key_len);
+extern RtnBool ObjectGetBool(ValuePtr ptr, const char* key, int key_len);
+extern RtnTypedString ObjectGetString(ValuePtr ptr,
+                                      const char* key,
+                                      int key_len);
+int ObjectHas(ValuePtr ptr, const char* key, int key_len);
+int ObjectHasKey(ValuePtr ptr, KeyPtr key);
 int ObjectHasAnyKey(ValuePtr ptr, ValuePtr key);
 int ObjectHasIdx(ValuePtr ptr, uint32_t idx);
-int ObjectDelete(ValuePtr ptr, const char* key);
+int ObjectDelete(ValuePtr ptr, const char* key, int key_len);
+int ObjectDeleteKey(ValuePtr ptr, KeyPtr key);
 int ObjectDeleteAnyKey(ValuePtr ptr, ValuePtr key);
 int ObjectDeleteIdx(ValuePtr ptr, uint32_t idx);
 
@@ -1,10 +1,13 @@
 #include "object_template.h"
+#include "_cgo_export.h"
 #include "context.h"
+#include "deps/include/v8-container.h"
 #include "deps/include/v8-context.h"
 #include "deps/include/v8-isolate.h"
 #include "deps/include/v8-locker.h"
 #include "deps/include/v8-template.h"
 #include "function_template.h"
+#include "isolate-macros.h"
 #include "template-macros.h"
 
 using namespace v8;
@@ -35,12 +38,7 @@ RtnValue ObjectTemplateNewInstance(TemplatePtr ptr, m_ctx* ctx) {
     return rtn;
   }
 
-  m_value* val = new m_value;
-  val->id = 0;
-  val->iso = iso;
-  val->ctx = ctx;
-  val->ptr = Global<Value>(iso, obj);
-  rtn.value = tracked_value(ctx, val);
+  rtn.value = tracked_value(ctx, obj);
   return rtn;
 }
 
@@ -67,13 +65,15 @@ int ObjectTemplateInternalFieldCount(TemplatePtr ptr) {
 
 void ObjectTemplateSetAccessorProperty(TemplatePtr ptr,
                                        const char* key,
+                                       int key_len,
                                        TemplatePtr get,
                                        TemplatePtr set,
                                        int attributes) {
   LOCAL_TEMPLATE(ptr);
 
   Local<String> key_val =
-      String::NewFromUtf8(iso, key, NewStringType::kNormal).ToLocalChecked();
+      String::NewFromUtf8(iso, key, NewStringType::kInternalized, key_len)
+          .ToLocalChecked();
   Local<ObjectTemplate> obj_tmpl = tmpl.As<ObjectTemplate>();
   Local<FunctionTemplate> get_tmpl =
       get ? get->ptr.Get(iso).As<FunctionTemplate>()
@@ -89,8 +89,340 @@ void ObjectTemplateSetAccessorProperty(TemplatePtr ptr,
 void ObjectTemplateSetCallAsFunctionHandler(TemplatePtr ptr, int callback_ref) {
   LOCAL_TEMPLATE(ptr);
 
-  Local<Integer> cbData = Integer::New(iso, callback_ref);
+  Local<Value> cbData =
+      NewCallbackData(iso, callback_ref, CALLBACK_TABLE_FUNCTION);
 
   Local<ObjectTemplate> obj_tmpl = tmpl.As<ObjectTemplate>();
   obj_tmpl->SetCallAsFunctionHandler(FunctionTemplateCallback, cbData);
 }
+
+/********** Property handlers **********/
+
+// releasePropertyValue releases a value passed to a property callback, unless
+// Go escaped it by clearing the pointer. The id is stale if Go released the
+// value itself.
+static void releasePropertyValue(m_ctx* ctx, ValuePtr val, long id) {
+  if (val == nullptr) {
+    return;
+  }
+  m_value* tracked = ctx->vals.Get(id);
+  if (tracked != nullptr) {
+    release_value(tracked);
+  }
+}
+
+// setPropertyResult passes a getter's result to V8. Only getters have a value
+// result; the other operations set theirs once the values are released.
+template <typename T>
+static void setPropertyResult(Isolate* iso,
+                              const PropertyCallbackInfo<T>& info,
+                              PropertyCallbackArgs* args) {}
+
+static void setPropertyResult(Isolate* iso,
+                              const PropertyCallbackInfo<Value>& info,
+                              PropertyCallbackArgs* args) {
+  if (args->error == nullptr && args->intercepted) {
+    info.GetReturnValue().Set(args->value->ptr.Get(iso));
+  }
+}
+
+// interceptProperty runs a property handler in Go. It returns kYes if Go
+// handled the operation, or threw an error. The receiver, and the value of a
+// set, only live for the duration of the callback, so intercepted accesses
+// don't accumulate values in the context.
+template <typename T>
+static Intercepted interceptProperty(Isolate* iso,
+                                     const PropertyCallbackInfo<T>& info,
+                                     PropertyCallbackArgs* args,
+                                     Local<Value> value = Local<Value>()) {
+  m_ctx* ctx = callbackContext(iso);
+  args->receiver = tracked_value(ctx, info.This());
+  long receiver_id = args->receiver->header.id;
+  long value_id = 0;
+  if (!value.IsEmpty()) {
+    args->value = tracked_value(ctx, value);
+    value_id = args->value->header.id;
+  }
+  goPropertyCallback(isolateHandle(iso), ctx->ref, callbackRef(info.Data()),
+                     args);
+
+  // The result may be the receiver, so it is copied into V8 first. A getter's
+  // result belongs to Go, and is never released here.
+  setPropertyResult(iso, info, args);
+  releasePropertyValue(ctx, args->receiver, receiver_id);
+  if (args->op == PROPERTY_OP_SET) {
+    releasePropertyValue(ctx, args->value, value_id);
+  }
+
+  if (args->error != nullptr) {
+    iso->ThrowException(args->error->ptr.Get(iso));
+    return Intercepted::kYes;
+  }
+  return args->intercepted ? Intercepted::kYes : Intercepted::kNo;
+}
+
+template <typename T>
+static Intercepted interceptGet(Isolate* iso,
+                                const PropertyCallbackInfo<T>& info,
+                                PropertyCallbackArgs* args) {
+  args->op = PROPERTY_OP_GET;
+  return interceptProperty(iso, info, args);
+}
+
+template <typename T>
+static Intercepted interceptSet(Isolate* iso,
+                                Local<Value> value,
+                                const PropertyCallbackInfo<T>& info,
+                                PropertyCallbackArgs* args) {
+  args->op = PROPERTY_OP_SET;
+  return interceptProperty(iso, info, args, value);
+}
+
+template <typename T>
+static Intercepted interceptQuery(Isolate* iso,
+                                  const PropertyCallbackInfo<T>& info,
+                                  PropertyCallbackArgs* args) {
+  args->op = PROPERTY_OP_QUERY;
+  Intercepted rtn = interceptProperty(iso, info, args);
+  if (args->error == nullptr && rtn == Intercepted::kYes) {
+    info.GetReturnValue().Set(args->attributes);
+  }
+  return rtn;
+}
+
+template <typename T>
+static Intercepted interceptDelete(Isolate* iso,
+                                   const PropertyCallbackInfo<T>& info,
+                                   PropertyCallbackArgs* args) {
+  args->op = PROPERTY_OP_DELETE;
+  Intercepted rtn = interceptProperty(iso, info, args);
+  if (args->error == nullptr && rtn == Intercepted::kYes) {
+    info.GetReturnValue().Set(true);
+  }
+  return rtn;
+}
+
+static void interceptEnumerate(Isolate* iso,
+                               const PropertyCallbackInfo<Array>& info,
+                               PropertyCallbackArgs* args) {
+  Local<Array> keys;
+  args->op = PROPERTY_OP_ENUMERATE;
+  args->keys = &keys;
+  interceptProperty(iso, info, args);
+  if (args->error == nullptr && !keys.IsEmpty()) {
+    info.GetReturnValue().Set(keys);
+  }
+}
+
+// Named handlers only see string keys, so the name is passed to Go as UTF-8.
+#define NAMED_PROPERTY_ARGS(name)       \
+  Isolate* iso = Isolate::GetCurrent(); \
+  ISOLATE_SCOPE(iso);                   \
+  String::Utf8Value utf8(iso, name);    \
+  PropertyCallbackArgs args = {};       \
+  args.name = *utf8;                    \
+  args.name_len = utf8.length();
+
+#define INDEXED_PROPERTY_ARGS(i)        \
+  Isolate* iso = Isolate::GetCurrent(); \
+  ISOLATE_SCOPE(iso);                   \
+  PropertyCallbackArgs args = {};       \
+  args.kind = PROPERTY_HANDLER_INDEXED; \
+  args.index = i;
+
+static Intercepted NamedPropertyGetter(Local<Name> name,
+                                       const PropertyCallbackInfo<Value>& info) {
+  NAMED_PROPERTY_ARGS(name);
+  return interceptGet(iso, info, &args);
+}
+
+static Intercepted NamedPropertySetter(Local<Name> name,
+                                       Local<Value> value,
+                                       const PropertyCallbackInfo<void>& info) {
+  NAMED_PROPERTY_ARGS(name);
+  return interceptSet(iso, value, info, &args);
+}
+
+static Intercepted NamedPropertyQuery(
+    Local<Name> name,
+    const PropertyCallbackInfo<Integer>& info) {
+  NAMED_PROPERTY_ARGS(name);
+  return interceptQuery(iso, info, &args);
+}
+
+static Intercepted NamedPropertyDeleter(
+    Local<Name> name,
+    const PropertyCallbackInfo<Boolean>& info) {
+  NAMED_PROPERTY_ARGS(name);
+  return interceptDelete(iso, info, &args);
+}
+
+static void NamedPropertyEnumerator(const PropertyCallbackInfo<Array>& info) {
+  Isolate* iso = Isolate::GetCurrent();
+  ISOLATE_SCOPE(iso);
+  PropertyCallbackArgs args = {};
+  interceptEnumerate(iso, info, &args);
+}
+
+static Intercepted IndexedPropertyGetter(
+    uint32_t index,
+    const PropertyCallbackInfo<Value>& info) {
+  INDEXED_PROPERTY_ARGS(index);
+  return interceptGet(iso, info, &args);
+}
+
+static Intercepted IndexedPropertySetter(
+    uint32_t index,
+    Local<Value> value,
+    const PropertyCallbackInfo<void>& info) {
+  INDEXED_PROPERTY_ARGS(index);
+  return interceptSet(iso, value, info, &args);
+}
+
+static Intercepted IndexedPropertyQuery(
+    uint32_t index,
+    const PropertyCallbackInfo<Integer>& info) {
+  INDEXED_PROPERTY_ARGS(index);
+  return interceptQuery(iso, info, &args);
+}
+
+static Intercepted IndexedPropertyDeleter(
+    uint32_t index,
+    const PropertyCallbackInfo<Boolean>& info) {
+  INDEXED_PROPERTY_ARGS(index);
+  return interceptDelete(iso, info, &args);
+}
+
+static void IndexedPropertyEnumerator(const PropertyCallbackInfo<Array>& info) {
+  Isolate* iso = Isolate::GetCurrent();
+  ISOLATE_SCOPE(iso);
+  PropertyCallbackArgs args = {};
+  args.kind = PROPERTY_HANDLER_INDEXED;
+  interceptEnumerate(iso, info, &args);
+}
+
+static void NativeDataPropertyGetter(Local<Name> name,
+                                     const PropertyCallbackInfo<Value>& info) {
+  Isolate* iso = Isolate::GetCurrent();
+  ISOLATE_SCOPE(iso);
+  PropertyCallbackArgs args = {};
+  args.kind = PROPERTY_HANDLER_DATA;
+  interceptGet(iso, info, &args);
+}
+
+static void NativeDataPropertySetter(Local<Name> name,
+                                     Local<Value> value,
+                                     const PropertyCallbackInfo<void>& info) {
+  Isolate* iso = Isolate::GetCurrent();
+  ISOLATE_SCOPE(iso);
+  PropertyCallbackArgs args = {};
+  args.kind = PROPERTY_HANDLER_DATA;
+  interceptSet(iso, value, info, &args);
+}
+
+#define HAS_OP(ops, op) (((ops) & (1 << (op))) != 0)
+
+void ObjectTemplateSetNamedHandler(TemplatePtr ptr, int callback_ref, int ops) {
+  LOCAL_TEMPLATE(ptr);
+
+  Local<Value> cbData =
+      NewCallbackData(iso, callback_ref, CALLBACK_TABLE_PROPERTY);
+
+  Local<ObjectTemplate> obj_tmpl = tmpl.As<ObjectTemplate>();
+  obj_tmpl->SetHandler(NamedPropertyHandlerConfiguration(
+      HAS_OP(ops, PROPERTY_OP_GET) ? NamedPropertyGetter : nullptr,
+      HAS_OP(ops, PROPERTY_OP_SET) ? NamedPropertySetter : nullptr,
+      HAS_OP(ops, PROPERTY_OP_QUERY) ? NamedPropertyQuery : nullptr,
+      HAS_OP(ops, PROPERTY_OP_DELETE) ? NamedPropertyDeleter : nullptr,
+      HAS_OP(ops, PROPERTY_OP_ENUMERATE) ? NamedPropertyEnumerator : nullptr,
+      cbData, PropertyHandlerFlags::kOnlyInterceptStrings));
+}
+
+void ObjectTemplateSetIndexedHandler(TemplatePtr ptr,
+                                     int callback_ref,
+                                     int ops) {
+  LOCAL_TEMPLATE(ptr);
+
+  Local<Value> cbData =
+      NewCallbackData(iso, callback_ref, CALLBACK_TABLE_PROPERTY);
+
+  Local<ObjectTemplate> obj_tmpl = tmpl.As<ObjectTemplate>();
+  obj_tmpl->SetHandler(IndexedPropertyHandlerConfiguration(
+      HAS_OP(ops, PROPERTY_OP_GET) ? IndexedPropertyGetter : nullptr,
+      HAS_OP(ops, PROPERTY_OP_SET) ? IndexedPropertySetter : nullptr,
+      HAS_OP(ops, PROPERTY_OP_QUERY) ? IndexedPropertyQuery : nullptr,
+      HAS_OP(ops, PROPERTY_OP_DELETE) ? IndexedPropertyDeleter : nullptr,
+      HAS_OP(ops, PROPERTY_OP_ENUMERATE) ? IndexedPropertyEnumerator : nullptr,
+      cbData));
+}
+
+void PropertyCallbackArgsSetNames(PropertyCallbackArgs* args,
+                                  const char* names,
+                                  const int* lens,
+                                  int n) {
+  Isolate* iso = Isolate::GetCurrent();
+  Local<Context> local_ctx = iso->GetCurrentContext();
+  Local<Array> keys = Array::New(iso, n);
+  for (int i = 0; i < n; ++i) {
+    Local<String> name;
+    if (!String::NewFromUtf8(iso, names, NewStringType::kInternalized, lens[i])
+             .ToLocal(&name) ||
+        keys->Set(local_ctx, i, name).IsNothing()) {
+      return;
+    }
+    names += lens[i];
+  }
+  *static_cast<Local<Array>*>(args->keys) = keys;
+}
+
+void PropertyCallbackArgsSetIndices(PropertyCallbackArgs* args,
+                                    const uint32_t* indices,
+                                    int n) {
+  Isolate* iso = Isolate::GetCurrent();
+  Local<Context> local_ctx = iso->GetCurrentContext();
+  Local<Array> keys = Array::New(iso, n);
+  for (int i = 0; i < n; ++i) {
+    if (keys->Set(local_ctx, i, Integer::NewFromUnsigned(iso, indices[i]))
+            .IsNothing()) {
+      return;
+    }
+  }
+  *static_cast<Local<Array>*>(args->keys) = keys;
+}
+
+void ObjectTemplateSetNativeDataProperty(TemplatePtr ptr,
+                                        const char* name,
+                                        int name_len,
+                                        int callback_ref,
+                                        int has_setter,
+                                        int attributes) {
+  LOCAL_TEMPLATE(ptr);
+
+  Local<String> name_val =
+      String::NewFromUtf8(iso, name, NewStringType::kInternalized, name_len)
+          .ToLocalChecked();
+  Local<Value> cbData =
+      NewCallbackData(iso, callback_ref, CALLBACK_TABLE_PROPERTY);
+
+  tmpl->SetNativeDataProperty(
+      name_val, NativeDataPropertyGetter,
+      has_setter ? NativeDataPropertySetter : nullptr, cbData,
+      (PropertyAttribute)attributes);
+}
+
+void ObjectTemplateSetLazyDataProperty(TemplatePtr ptr,
+                                      const char* name,
+                                      int name_len,
+                                      int callback_ref,
+                                      int attributes) {
+  LOCAL_TEMPLATE(ptr);
+
+  Local<String> name_val =
+      String::NewFromUtf8(iso, name, NewStringType::kInternalized, name_len)
+          .ToLocalChecked();
+  Local<Value> cbData =
+      NewCallbackData(iso, callback_ref, CALLBACK_TABLE_PROPERTY);
+
+  tmpl->SetLazyDataProperty(name_val, NativeDataPropertyGetter, cbData,
+                            (PropertyAttribute)attributes);
+}
@@ -10,7 +10,6 @@ import "C"
 import (
 	"errors"
 	"runtime"
-	"unsafe"
 )
 
 // PropertyAttribute are the attribute flags for a property on an Object.
@@ -42,6 +41,7 @@ func NewObjectTemplate(iso *Isolate) *ObjectTemplate {
 		panic("nil Isolate argument not supported")
 	}
 
+	iso.releaseTemplates()
 	tmpl := &template{
 		ptr: C.NewObjectTemplate(iso.ptr),
 		iso: iso,
@@ -81,8 +81,7 @@ func (o *ObjectTemplate) SetAccessorProperty(
 	set *FunctionTemplate,
 	attributes PropertyAttribute,
 ) {
-	ckey := C.CString(key)
-	defer C.free(unsafe.Pointer(ckey))
+	ckey, keyLen := cStringN(key)
 	var (
 		getter C.TemplatePtr
 		setter C.TemplatePtr
@@ -93,7 +92,7 @@ func (o *ObjectTemplate) SetAccessorProperty(
 	if set != nil {
 		setter = set.ptr
 	}
-	C.ObjectTemplateSetAccessorProperty(o.ptr, ckey, getter, setter, C.int(attributes))
+	C.ObjectTemplateSetAccessorProperty(o.ptr, ckey, keyLen, getter, setter, C.int(attributes))
 }
 
 // InternalFieldCount returns the number of internal fields that instances of this
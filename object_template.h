@@ -1,6 +1,8 @@
 #ifndef V8GO_OBJECT_TEMPLATE_H
 #define V8GO_OBJECT_TEMPLATE_H
 
+#include <stdint.h>
+
 #include "errors.h"
 #include "template.h"
 
@@ -22,6 +24,44 @@ typedef struct v8Isolate v8Isolate;
 typedef struct m_ctx m_ctx;
 typedef struct m_template m_template;
 
+// The operations of a property handler. The callbacks a handler has are
+// passed to ObjectTemplateSet*Handler as a bit mask of 1 << op.
+typedef enum {
+  PROPERTY_OP_GET = 0,
+  PROPERTY_OP_SET,
+  PROPERTY_OP_QUERY,
+  PROPERTY_OP_DELETE,
+  PROPERTY_OP_ENUMERATE,
+} PropertyOp;
+
+// The kinds of property callbacks.
+typedef enum {
+  PROPERTY_HANDLER_NAMED = 0,
+  PROPERTY_HANDLER_INDEXED,
+  PROPERTY_HANDLER_DATA,
+} PropertyHandlerKind;
+
+// PropertyCallbackArgs carries an intercepted property operation to Go, and
+// its result back.
+typedef struct {
+  PropertyOp op;
+  PropertyHandlerKind kind;
+  const char* name;
+  int name_len;
+  uint32_t index;
+  // The receiver, and the value being set, are released when the callback
+  // returns. Go clears them to escape them.
+  ValuePtr receiver;
+  // The value being set, or the value got.
+  ValuePtr value;
+
+  int intercepted;
+  int attributes;
+  ValuePtr error;
+  // The v8::Local<v8::Array> receiving enumerated keys.
+  void* keys;
+} PropertyCallbackArgs;
+
 extern TemplatePtr NewObjectTemplate(v8Isolate* iso_ptr);
 extern RtnValue ObjectTemplateNewInstance(m_template* ptr, m_ctx* ctx_ptr);
 extern void ObjectTemplateSetInternalFieldCount(m_template* ptr,
@@ -29,12 +69,37 @@ extern void ObjectTemplateSetInternalFieldCount(m_template* ptr,
 extern int ObjectTemplateInternalFieldCount(m_template* ptr);
 extern void ObjectTemplateSetAccessorProperty(m_template* ptr,
                                               const char* key,
+                                              int key_len,
                                               m_template* get,
                                               m_template* set,
                                               int attributes);
 extern void ObjectTemplateMarkAsUndetectable(m_template* ptr);
 extern void ObjectTemplateSetCallAsFunctionHandler(m_template* ptr,
                                                    int callback_ref);
+extern void ObjectTemplateSetNamedHandler(m_template* ptr,
+                                          int callback_ref,
+                                          int ops);
+extern void ObjectTemplateSetIndexedHandler(m_template* ptr,
+                                            int callback_ref,
+                                            int ops);
+extern void ObjectTemplateSetNativeDataProperty(m_template* ptr,
+                                               const char* name,
+                                               int name_len,
+                                               int callback_ref,
+                                               int has_setter,
+                                               int attributes);
+extern void ObjectTemplateSetLazyDataProperty(m_template* ptr,
+                                             const char* name,
+                                             int name_len,
+                                             int callback_ref,
+                                             int attributes);
+extern void PropertyCallbackArgsSetNames(PropertyCallbackArgs* args,
+                                         const char* names,
+                                         const int* lens,
+                                         int n);
+extern void PropertyCallbackArgsSetIndices(PropertyCallbackArgs* args,
+                                           const uint32_t* indices,
+                                           int n);
 
 #ifdef __cplusplus
 }
@@ -392,3 +392,227 @@ func TestObjectTemplateMarkAsUndetectableOnInstanceTemplate(t *testing.T) {
 		}
 	}
 }
+
+func TestObjectTemplateSetNamedHandler(t *testing.T) {
+	t.Parallel()
+	iso := v8.NewIsolate()
+	defer iso.Dispose()
+
+	props := map[string]string{"a": "1", "b": "2"}
+	tmpl := v8.NewObjectTemplate(iso)
+	tmpl.SetNamedHandler(&v8.NamedPropertyHandler{
+		Getter: func(info *v8.PropertyCallbackInfo, name string) (*v8.Value, error) {
+			if name == "fail" {
+				return nil, fmt.Errorf("no %s", name)
+			}
+			if s, ok := props[name]; ok {
+				return v8.NewValue(iso, s)
+			}
+			return nil, nil
+		},
+		Setter: func(info *v8.PropertyCallbackInfo, name string, value *v8.Value) (bool, error) {
+			if name == "own" {
+				return false, nil
+			}
+			props[name] = value.String()
+			return true, nil
+		},
+		Query: func(info *v8.PropertyCallbackInfo, name string) (v8.PropertyAttribute, bool) {
+			_, ok := props[name]
+			return v8.None, ok
+		},
+		Deleter: func(info *v8.PropertyCallbackInfo, name string) (bool, error) {
+			_, ok := props[name]
+			delete(props, name)
+			return ok, nil
+		},
+		Enumerator: func(info *v8.PropertyCallbackInfo) []string {
+			var names []string
+			for name := range props {
+				names = append(names, name)
+			}
+			return names
+		},
+	})
+
+	global := v8.NewObjectTemplate(iso)
+	global.Set("obj", tmpl)
+	ctx := v8.NewContext(iso, global)
+	defer ctx.Close()
+
+	tests := [...]struct {
+		source string
+		want   string
+	}{
+		{"obj.a + obj.b", "12"},
+		{"obj.c = 3; obj.c", "3"},
+		{"obj.own = 4; obj.own", "4"},
+		{"'a' in obj", "true"},
+		{"delete obj.a; obj.a", "undefined"},
+		{"Object.keys(obj).sort().join()", "b,c,own"},
+	}
+	for _, tt := range tests {
+		val, err := ctx.RunScript(tt.source, "")
+		fatalIf(t, err)
+		if got := val.String(); got != tt.want {
+			t.Errorf("%s: expected %s, got %s", tt.source, tt.want, got)
+		}
+	}
+	if _, ok := props["own"]; ok {
+		t.Error("expected a declined set to go to the object")
+	}
+
+	if _, err := ctx.RunScript("obj.fail", ""); err == nil {
+		t.Error("expected getter error to be thrown")
+	}
+}
+
+func TestObjectTemplateSetIndexedHandler(t *testing.T) {
+	t.Parallel()
+	iso := v8.NewIsolate()
+	defer iso.Dispose()
+
+	elems := []int32{10, 20, 30}
+	tmpl := v8.NewObjectTemplate(iso)
+	tmpl.SetIndexedHandler(&v8.IndexedPropertyHandler{
+		Getter: func(info *v8.PropertyCallbackInfo, index uint32) (*v8.Value, error) {
+			if index >= uint32(len(elems)) {
+				return nil, nil
+			}
+			return v8.NewValue(iso, elems[index])
+		},
+		Setter: func(info *v8.PropertyCallbackInfo, index uint32, value *v8.Value) (bool, error) {
+			if index >= uint32(len(elems)) {
+				return false, nil
+			}
+			elems[index] = value.Int32()
+			return true, nil
+		},
+		Enumerator: func(info *v8.PropertyCallbackInfo) []uint32 {
+			indices := make([]uint32, len(elems))
+			for i := range indices {
+				indices[i] = uint32(i)
+			}
+			return indices
+		},
+	})
+
+	global := v8.NewObjectTemplate(iso)
+	global.Set("arr", tmpl)
+	ctx := v8.NewContext(iso, global)
+	defer ctx.Close()
+
+	val, err := ctx.RunScript("arr[1] = 21; arr[0] + arr[1] + arr[2]", "")
+	fatalIf(t, err)
+	if got := val.Int32(); got != 61 {
+		t.Errorf("expected 61, got %d", got)
+	}
+	if elems[1] != 21 {
+		t.Errorf("expected the setter to update the slice, got %v", elems)
+	}
+
+	val, err = ctx.RunScript("Object.keys(arr).join()", "")
+	fatalIf(t, err)
+	if got := val.String(); got != "0,1,2" {
+		t.Errorf("expected 0,1,2, got %s", got)
+	}
+}
+
+func TestObjectTemplateHandlerReleasesValues(t *testing.T) {
+	t.Parallel()
+	iso := v8.NewIsolate()
+	defer iso.Dispose()
+
+	one, err := v8.NewValue(iso, int32(1))
+	fatalIf(t, err)
+	var escaped *v8.Value
+	tmpl := v8.NewObjectTemplate(iso)
+	tmpl.SetNamedHandler(&v8.NamedPropertyHandler{
+		Getter: func(info *v8.PropertyCallbackInfo, name string) (*v8.Value, error) {
+			if name == "self" {
+				return info.This().Value, nil
+			}
+			return one, nil
+		},
+		Setter: func(info *v8.PropertyCallbackInfo, name string, value *v8.Value) (bool, error) {
+			if name == "keep" {
+				escaped = info.Escape(value)
+			}
+			return true, nil
+		},
+	})
+
+	global := v8.NewObjectTemplate(iso)
+	global.Set("obj", tmpl)
+	ctx := v8.NewContext(iso, global)
+	defer ctx.Close()
+
+	before := ctx.RetainedValueCount()
+	val, err := ctx.RunScript(`
+		let sum = 0;
+		for (let i = 0; i < 10000; i++) {
+			sum += obj.x;
+			obj.y = i;
+		}
+		obj.self === obj ? sum : -1
+	`, "")
+	fatalIf(t, err)
+	if got := val.Int32(); got != 10000 {
+		t.Errorf("expected 10000, got %d", got)
+	}
+	// Only the script's result is retained.
+	if n := ctx.RetainedValueCount(); n != before+1 {
+		t.Errorf("expected %d retained values, got %d", before+1, n)
+	}
+
+	_, err = ctx.RunScript("obj.keep = 'kept'", "")
+	fatalIf(t, err)
+	if escaped.String() != "kept" {
+		t.Errorf("expected escaped value to be kept, got %s", escaped)
+	}
+}
+
+func TestObjectTemplateSetNativeDataProperty(t *testing.T) {
+	t.Parallel()
+	iso := v8.NewIsolate()
+	defer iso.Dispose()
+
+	var reads, lazyReads int
+	value := "foo"
+	tmpl := v8.NewObjectTemplate(iso)
+	tmpl.SetNativeDataProperty("prop", func(info *v8.PropertyCallbackInfo) (*v8.Value, error) {
+		reads++
+		return v8.NewValue(iso, value)
+	}, func(info *v8.PropertyCallbackInfo, v *v8.Value) error {
+		value = v.String()
+		return nil
+	}, v8.None)
+	tmpl.SetNativeDataProperty("readOnly", func(info *v8.PropertyCallbackInfo) (*v8.Value, error) {
+		return v8.NewValue(iso, "fixed")
+	}, nil, v8.None)
+	tmpl.SetLazyDataProperty("lazy", func(info *v8.PropertyCallbackInfo) (*v8.Value, error) {
+		lazyReads++
+		return v8.NewValue(iso, int32(42))
+	}, v8.None)
+
+	global := v8.NewObjectTemplate(iso)
+	global.Set("obj", tmpl)
+	ctx := v8.NewContext(iso, global)
+	defer ctx.Close()
+
+	val, err := ctx.RunScript(`
+		obj.prop = "bar";
+		obj.readOnly = "changed";
+		[obj.prop, obj.prop, obj.readOnly, obj.lazy, obj.lazy, typeof Object.getOwnPropertyDescriptor(obj, "prop").get].join()
+	`, "")
+	fatalIf(t, err)
+	if want := "bar,bar,fixed,42,42,undefined"; val.String() != want {
+		t.Errorf("expected %s, got %s", want, val)
+	}
+	if reads != 2 {
+		t.Errorf("expected 2 reads of the native property, got %d", reads)
+	}
+	if lazyReads != 1 {
+		t.Errorf("expected 1 read of the lazy property, got %d", lazyReads)
+	}
+}
@@ -139,6 +139,45 @@ func TestObjectInternalFields(t *testing.T) {
 	}
 }
 
+func TestObjectAlignedPointerInternalFields(t *testing.T) {
+	t.Parallel()
+
+	iso := v8.NewIsolate(v8.WithScopedCallbackArgs())
+	defer iso.Dispose()
+
+	type point struct{ x, y int32 }
+	points := []point{{1, 2}, {3, 4}}
+
+	tmpl := v8.NewObjectTemplate(iso)
+	tmpl.SetInternalFieldCount(1)
+	sum := v8.NewFunctionTemplate(iso, func(info *v8.FunctionCallbackInfo) *v8.Value {
+		p := points[info.ThisAlignedPointer(0)]
+		v, _ := v8.NewValue(iso, p.x+p.y)
+		return v
+	})
+	tmpl.Set("sum", sum)
+	ctx := v8.NewContext(iso)
+	defer ctx.Close()
+
+	obj, err := tmpl.NewInstance(ctx)
+	fatalIf(t, err)
+	obj.SetAlignedPointerInInternalField(0, 1)
+	if v := obj.GetAlignedPointerFromInternalField(0); v != 1 {
+		t.Errorf("expected 1, got %d", v)
+	}
+	fatalIf(t, ctx.Global().Set("p", obj))
+
+	val, err := ctx.RunScript("p.sum()", "")
+	fatalIf(t, err)
+	if got := val.Int32(); got != 7 {
+		t.Errorf("expected 7, got %d", got)
+	}
+
+	if recoverPanic(func() { obj.SetAlignedPointerInInternalField(1, 0) }) == nil {
+		t.Error("expected panic from index out of bounds")
+	}
+}
+
 func TestObjectGet(t *testing.T) {
 	t.Parallel()
 
@@ -169,6 +208,54 @@ func TestObjectGet(t *testing.T) {
 	}
 }
 
+func TestObjectGetTyped(t *testing.T) {
+	t.Parallel()
+
+	ctx := v8.NewContext()
+	defer ctx.Isolate().Dispose()
+	defer ctx.Close()
+	val, err := ctx.RunScript(`({
+		i: 42,
+		f: 1.5,
+		b: true,
+		s: 'héllo',
+		get boom() { throw new Error('boom'); },
+	})`, "")
+	fatalIf(t, err)
+	obj, err := val.AsObject()
+	fatalIf(t, err)
+	before := ctx.RetainedValueCount()
+
+	if got, err := obj.GetInt32("i"); err != nil || got != 42 {
+		t.Errorf("GetInt32: got %v, %v", got, err)
+	}
+	if got, err := obj.GetFloat64("f"); err != nil || got != 1.5 {
+		t.Errorf("GetFloat64: got %v, %v", got, err)
+	}
+	if got, err := obj.GetFloat64("i"); err != nil || got != 42 {
+		t.Errorf("GetFloat64 of an integer: got %v, %v", got, err)
+	}
+	if got, err := obj.GetBool("b"); err != nil || !got {
+		t.Errorf("GetBool: got %v, %v", got, err)
+	}
+	if got, err := obj.GetString("s"); err != nil || got != "héllo" {
+		t.Errorf("GetString: got %q, %v", got, err)
+	}
+	if n := ctx.RetainedValueCount(); n != before {
+		t.Errorf("expected typed getters not to retain values, got %d more", n-before)
+	}
+
+	if _, err := obj.GetInt32("f"); err == nil {
+		t.Error("expected an error getting a non-integer as Int32")
+	}
+	if _, err := obj.GetString("missing"); err == nil {
+		t.Error("expected an error getting undefined as String")
+	}
+	if _, err := obj.GetBool("boom"); err == nil || err.Error() != "Error: boom" {
+		t.Errorf("expected the getter exception, got %v", err)
+	}
+}
+
 func TestObjectHas(t *testing.T) {
 	t.Parallel()
 
@@ -225,6 +312,49 @@ func TestObjectDelete(t *testing.T) {
 
 }
 
+func TestObjectKey(t *testing.T) {
+	t.Parallel()
+
+	ctx := v8.NewContext()
+	iso := ctx.Isolate()
+	defer iso.Dispose()
+	defer ctx.Close()
+
+	name := iso.Key("name")
+	if iso.Key("name") != name {
+		t.Error("expected keys to be cached per name")
+	}
+
+	val, err := ctx.RunScript(`({ name: "v8go" })`, "")
+	fatalIf(t, err)
+	obj, err := val.AsObject()
+	fatalIf(t, err)
+
+	got, err := obj.GetKey(name)
+	fatalIf(t, err)
+	if s := got.String(); s != "v8go" {
+		t.Errorf("expected name to be v8go, got %q", s)
+	}
+
+	count := iso.Key("count")
+	fatalIf(t, obj.SetKey(count, int32(3)))
+	if n, err := obj.GetInt32("count"); err != nil || n != 3 {
+		t.Errorf("expected count to be 3, got %d, %v", n, err)
+	}
+	if !obj.HasKey(count) {
+		t.Error("expected count to exist")
+	}
+	if !obj.DeleteKey(count) || obj.HasKey(count) {
+		t.Error("expected count to be deleted")
+	}
+
+	other := v8.NewIsolate()
+	defer other.Dispose()
+	if recoverPanic(func() { obj.GetKey(other.Key("name")) }) == nil {
+		t.Error("expected panic on a key of another isolate")
+	}
+}
+
 func ExampleObject_global() {
 	iso := v8.NewIsolate()
 	defer iso.Dispose()
@@ -9,6 +9,7 @@ package v8go
 import "C"
 import (
 	"errors"
+	"runtime"
 )
 
 // PromiseState is the state of the Promise.
@@ -53,7 +54,8 @@ func NewPromiseResolver(ctx *Context) (*PromiseResolver, error) {
 func (r *PromiseResolver) GetPromise() *Promise {
 	if r.prom == nil {
 		ptr := C.PromiseResolverGetPromise(r.ptr)
-		val := &Value{ptr, r.ctx}
+		runtime.KeepAlive(r)
+		val := newValue(ptr, r.ctx)
 		r.prom = &Promise{&Object{val}}
 	}
 	return r.prom
@@ -62,18 +64,26 @@ func (r *PromiseResolver) GetPromise() *Promise {
 // Resolve invokes the Promise resolve state with the given value.
 // The Promise state will transition from Pending to Fulfilled.
 func (r *PromiseResolver) Resolve(val Valuer) bool {
-	return C.PromiseResolverResolve(r.ptr, val.value().ptr) != 0
+	rtn := C.PromiseResolverResolve(r.ptr, val.value().ptr) != 0
+	runtime.KeepAlive(r)
+	runtime.KeepAlive(val)
+	return rtn
 }
 
 // Reject invokes the Promise reject state with the given value.
 // The Promise state will transition from Pending to Rejected.
 func (r *PromiseResolver) Reject(err *Value) bool {
-	return C.PromiseResolverReject(r.ptr, err.ptr) != 0
+	rtn := C.PromiseResolverReject(r.ptr, err.ptr) != 0
+	runtime.KeepAlive(r)
+	runtime.KeepAlive(err)
+	return rtn
 }
 
 // State returns the current state of the Promise.
 func (p *Promise) State() PromiseState {
-	return PromiseState(C.PromiseState(p.ptr))
+	rtn := PromiseState(C.PromiseState(p.ptr))
+	runtime.KeepAlive(p)
+	return rtn
 }
 
 // Result is the value result of the Promise. The Promise must
@@ -81,7 +91,8 @@ func (p *Promise) State() PromiseState {
 // to validate state before calling for the result.
 func (p *Promise) Result() *Value {
 	ptr := C.PromiseResult(p.ptr)
-	val := &Value{ptr, p.ctx}
+	runtime.KeepAlive(p)
+	val := newValue(ptr, p.ctx)
 	return val
 }
 
@@ -111,10 +122,12 @@ func (p *Promise) ThenWithError(cbs ...FunctionCallbackWithError) *Promise {
 	case 1:
 		cbID := p.ctx.iso.registerCallback(cbs[0])
 		rtn = C.PromiseThen(p.ptr, C.int(cbID))
+		runtime.KeepAlive(p)
 	case 2:
 		cbID1 := p.ctx.iso.registerCallback(cbs[0])
 		cbID2 := p.ctx.iso.registerCallback(cbs[1])
 		rtn = C.PromiseThen2(p.ptr, C.int(cbID1), C.int(cbID2))
+		runtime.KeepAlive(p)
 
 	default:
 		panic("1 or 2 callbacks required")
@@ -137,6 +150,7 @@ func (p *Promise) Catch(cb FunctionCallback) *Promise {
 func (p *Promise) CatchWithError(cb FunctionCallbackWithError) *Promise {
 	cbID := p.ctx.iso.registerCallback(cb)
 	rtn := C.PromiseCatch(p.ptr, C.int(cbID))
+	runtime.KeepAlive(p)
 	obj, err := objectResult(p.ctx, rtn)
 	if err != nil {
 		panic(err) // TODO: Return error
@@ -0,0 +1,300 @@
+package v8go
+
+// #include "object_template.h"
+import "C"
+import (
+	"runtime"
+	"unsafe"
+)
+
+// PropertyCallbackInfo is the argument passed to the callbacks of a
+// NamedPropertyHandler or IndexedPropertyHandler.
+//
+// The receiver, and the value passed to a setter, are released when the
+// callback returns, so that intercepted accesses don't accumulate values in
+// the context. Values that must outlive the callback have to be passed to
+// Escape. The PropertyCallbackInfo itself must not be used after the callback
+// returns.
+type PropertyCallbackInfo struct {
+	ctx  *Context
+	this *Object
+	args *C.PropertyCallbackArgs
+}
+
+// Context is the current context that the callback is being executed in.
+func (i *PropertyCallbackInfo) Context() *Context {
+	return i.ctx
+}
+
+// This returns the receiver object "this", on which the property is
+// accessed.
+func (i *PropertyCallbackInfo) This() *Object {
+	return i.this
+}
+
+// Escape keeps v alive after the callback returns, if it is the receiver or
+// the value being set. Other values are never released automatically. It
+// returns v's underlying Value for convenience.
+func (i *PropertyCallbackInfo) Escape(v Valuer) *Value {
+	val := v.value()
+	if val.ptr == i.args.receiver {
+		i.args.receiver = nil
+	} else if i.args.op == C.PROPERTY_OP_SET && val.ptr == i.args.value {
+		i.args.value = nil
+	}
+	return val
+}
+
+// NamedPropertyHandler intercepts access to the string-keyed properties of
+// objects created from an ObjectTemplate, so they can be resolved on demand
+// instead of being set up front. Any callback may be nil, in which case the
+// operation is not intercepted. Operations a callback declines fall through
+// to the object's own properties.
+//
+// This corresponds to NamedPropertyHandlerConfiguration in the C++ API.
+type NamedPropertyHandler struct {
+	// Getter returns the value of the property, or nil to decline.
+	Getter func(info *PropertyCallbackInfo, name string) (*Value, error)
+	// Setter handles an assignment, or returns false to decline.
+	Setter func(info *PropertyCallbackInfo, name string, value *Value) (bool, error)
+	// Query returns the attributes of the property, or false to decline.
+	Query func(info *PropertyCallbackInfo, name string) (PropertyAttribute, bool)
+	// Deleter deletes the property, or returns false to decline.
+	Deleter func(info *PropertyCallbackInfo, name string) (bool, error)
+	// Enumerator returns the names of the intercepted properties, as seen by
+	// e.g. `Object.keys` and `for-in` loops.
+	Enumerator func(info *PropertyCallbackInfo) []string
+}
+
+// IndexedPropertyHandler intercepts access to the integer-keyed properties of
+// objects created from an ObjectTemplate. It works like NamedPropertyHandler.
+//
+// This corresponds to IndexedPropertyHandlerConfiguration in the C++ API.
+type IndexedPropertyHandler struct {
+	// Getter returns the value of the element, or nil to decline.
+	Getter func(info *PropertyCallbackInfo, index uint32) (*Value, error)
+	// Setter handles an assignment, or returns false to decline.
+	Setter func(info *PropertyCallbackInfo, index uint32, value *Value) (bool, error)
+	// Query returns the attributes of the element, or false to decline.
+	Query func(info *PropertyCallbackInfo, index uint32) (PropertyAttribute, bool)
+	// Deleter deletes the element, or returns false to decline.
+	Deleter func(info *PropertyCallbackInfo, index uint32) (bool, error)
+	// Enumerator returns the indices of the intercepted elements.
+	Enumerator func(info *PropertyCallbackInfo) []uint32
+}
+
+// PropertyGetter returns the value of a native data property. A nil value
+// is undefined.
+type PropertyGetter func(info *PropertyCallbackInfo) (*Value, error)
+
+// PropertySetter is called when a native data property is assigned.
+type PropertySetter func(info *PropertyCallbackInfo, value *Value) error
+
+type dataProperty struct {
+	get PropertyGetter
+	set PropertySetter
+}
+
+type propertyHandler struct {
+	named   *NamedPropertyHandler
+	indexed *IndexedPropertyHandler
+	data    *dataProperty
+}
+
+// SetNamedHandler makes objects created from this template call h when their
+// string-keyed properties are accessed.
+func (o *ObjectTemplate) SetNamedHandler(h *NamedPropertyHandler) {
+	if h == nil {
+		panic("nil NamedPropertyHandler argument not supported")
+	}
+	ops := propertyOps(h.Getter != nil, h.Setter != nil, h.Query != nil, h.Deleter != nil, h.Enumerator != nil)
+	ref := o.iso.props.add(&propertyHandler{named: h})
+	C.ObjectTemplateSetNamedHandler(o.ptr, C.int(ref), ops)
+	runtime.KeepAlive(o)
+}
+
+// SetIndexedHandler makes objects created from this template call h when
+// their integer-keyed properties are accessed.
+func (o *ObjectTemplate) SetIndexedHandler(h *IndexedPropertyHandler) {
+	if h == nil {
+		panic("nil IndexedPropertyHandler argument not supported")
+	}
+	ops := propertyOps(h.Getter != nil, h.Setter != nil, h.Query != nil, h.Deleter != nil, h.Enumerator != nil)
+	ref := o.iso.props.add(&propertyHandler{indexed: h})
+	C.ObjectTemplateSetIndexedHandler(o.ptr, C.int(ref), ops)
+	runtime.KeepAlive(o)
+}
+
+// SetNativeDataProperty adds a property to each instance created by this
+// template, whose value is computed by get on every read. Unlike
+// SetAccessorProperty, no JS functions are created, and the property looks
+// like a data property to JS. If set is nil, assignments have no effect.
+//
+// This corresponds to Template::SetNativeDataProperty in the C++ API.
+func (o *ObjectTemplate) SetNativeDataProperty(name string, get PropertyGetter, set PropertySetter, attributes PropertyAttribute) {
+	if get == nil {
+		panic("nil PropertyGetter argument not supported")
+	}
+	cname, nameLen := cStringN(name)
+
+	var hasSetter C.int
+	if set != nil {
+		hasSetter = 1
+	}
+	ref := o.iso.props.add(&propertyHandler{data: &dataProperty{get: get, set: set}})
+	C.ObjectTemplateSetNativeDataProperty(o.ptr, cname, nameLen, C.int(ref), hasSetter, C.int(attributes))
+	runtime.KeepAlive(o)
+}
+
+// SetLazyDataProperty adds a property to each instance created by this
+// template, whose value is computed by get on first access. V8 then replaces
+// it with a plain data property holding the value.
+//
+// This corresponds to Template::SetLazyDataProperty in the C++ API.
+func (o *ObjectTemplate) SetLazyDataProperty(name string, get PropertyGetter, attributes PropertyAttribute) {
+	if get == nil {
+		panic("nil PropertyGetter argument not supported")
+	}
+	cname, nameLen := cStringN(name)
+
+	ref := o.iso.props.add(&propertyHandler{data: &dataProperty{get: get}})
+	C.ObjectTemplateSetLazyDataProperty(o.ptr, cname, nameLen, C.int(ref), C.int(attributes))
+	runtime.KeepAlive(o)
+}
+
+func propertyOps(get, set, query, del, enum bool) C.int {
+	var ops C.int
+	for op, ok := range [...]bool{
+		C.PROPERTY_OP_GET:       get,
+		C.PROPERTY_OP_SET:       set,
+		C.PROPERTY_OP_QUERY:     query,
+		C.PROPERTY_OP_DELETE:    del,
+		C.PROPERTY_OP_ENUMERATE: enum,
+	} {
+		if ok {
+			ops |= 1 << op
+		}
+	}
+	return ops
+}
+
+//export goPropertyCallback
+func goPropertyCallback(isoHandle C.uintptr_t, ctxref int, cbref int, args *C.PropertyCallbackArgs) {
+	ctx := isolateFromHandle(isoHandle).getContext(ctxref)
+	ctx.releaseQueued()
+
+	h := ctx.iso.props.get(cbref)
+	info := &PropertyCallbackInfo{
+		ctx:  ctx,
+		this: &Object{newValue(args.receiver, ctx)},
+		args: args,
+	}
+	var err error
+	switch args.kind {
+	case C.PROPERTY_HANDLER_NAMED:
+		err = h.named.call(info, args)
+	case C.PROPERTY_HANDLER_INDEXED:
+		err = h.indexed.call(info, args)
+	case C.PROPERTY_HANDLER_DATA:
+		err = h.data.call(info, args)
+	}
+	if err != nil {
+		args.error = callbackError(ctx, err)
+	}
+}
+
+func (h *NamedPropertyHandler) call(info *PropertyCallbackInfo, args *C.PropertyCallbackArgs) error {
+	if args.op == C.PROPERTY_OP_ENUMERATE {
+		names := h.Enumerator(info)
+		if len(names) == 0 {
+			return nil
+		}
+		var buf []byte
+		lens := make([]C.int, len(names))
+		for i, name := range names {
+			buf = append(buf, name...)
+			lens[i] = C.int(len(name))
+		}
+		var cbuf *C.char
+		if len(buf) > 0 {
+			cbuf = (*C.char)(unsafe.Pointer(&buf[0]))
+		}
+		C.PropertyCallbackArgsSetNames(args, cbuf, &lens[0], C.int(len(names)))
+		return nil
+	}
+
+	name := C.GoStringN(args.name, args.name_len)
+	switch args.op {
+	case C.PROPERTY_OP_GET:
+		val, err := h.Getter(info, name)
+		return setPropertyValue(args, val, err)
+	case C.PROPERTY_OP_SET:
+		ok, err := h.Setter(info, name, newValue(args.value, info.ctx))
+		return setPropertyIntercepted(args, ok, err)
+	case C.PROPERTY_OP_QUERY:
+		attrs, ok := h.Query(info, name)
+		return setPropertyAttributes(args, attrs, ok)
+	case C.PROPERTY_OP_DELETE:
+		ok, err := h.Deleter(info, name)
+		return setPropertyIntercepted(args, ok, err)
+	}
+	return nil
+}
+
+func (h *IndexedPropertyHandler) call(info *PropertyCallbackInfo, args *C.PropertyCallbackArgs) error {
+	index := uint32(args.index)
+	switch args.op {
+	case C.PROPERTY_OP_GET:
+		val, err := h.Getter(info, index)
+		return setPropertyValue(args, val, err)
+	case C.PROPERTY_OP_SET:
+		ok, err := h.Setter(info, index, newValue(args.value, info.ctx))
+		return setPropertyIntercepted(args, ok, err)
+	case C.PROPERTY_OP_QUERY:
+		attrs, ok := h.Query(info, index)
+		return setPropertyAttributes(args, attrs, ok)
+	case C.PROPERTY_OP_DELETE:
+		ok, err := h.Deleter(info, index)
+		return setPropertyIntercepted(args, ok, err)
+	case C.PROPERTY_OP_ENUMERATE:
+		indices := h.Enumerator(info)
+		if len(indices) > 0 {
+			C.PropertyCallbackArgsSetIndices(args, (*C.uint32_t)(unsafe.Pointer(&indices[0])), C.int(len(indices)))
+		}
+	}
+	return nil
+}
+
+func (p *dataProperty) call(info *PropertyCallbackInfo, args *C.PropertyCallbackArgs) error {
+	switch args.op {
+	case C.PROPERTY_OP_GET:
+		val, err := p.get(info)
+		return setPropertyValue(args, val, err)
+	case C.PROPERTY_OP_SET:
+		return p.set(info, newValue(args.value, info.ctx))
+	}
+	return nil
+}
+
+func setPropertyValue(args *C.PropertyCallbackArgs, val *Value, err error) error {
+	if err == nil && val != nil {
+		args.value = val.ptr
+		args.intercepted = 1
+	}
+	return err
+}
+
+func setPropertyIntercepted(args *C.PropertyCallbackArgs, ok bool, err error) error {
+	if err == nil && ok {
+		args.intercepted = 1
+	}
+	return err
+}
+
+func setPropertyAttributes(args *C.PropertyCallbackArgs, attrs PropertyAttribute, ok bool) error {
+	if ok {
+		args.attributes = C.int(attrs)
+		args.intercepted = 1
+	}
+	return nil
+}
@@ -0,0 +1,92 @@
+package v8go
+
+import (
+	"sync"
+	"sync/atomic"
+)
+
+const refChunkSize = 256
+
+type refChunk[T any] [refChunkSize]atomic.Pointer[T]
+
+// refTable maps small integer references, which can be handed to C, to Go
+// objects. Lookups are lock-free, so callbacks from V8 don't contend with
+// each other; adding and removing entries takes a mutex. Entries live in
+// fixed-size chunks, so growing the table only copies the chunk list.
+//
+// Reference 0 is never used, so C code can use it as "none".
+type refTable[T any] struct {
+	chunks atomic.Pointer[[]*refChunk[T]]
+
+	mu   sync.Mutex
+	next int
+	free []int
+}
+
+// add stores v and returns its reference.
+func (t *refTable[T]) add(v *T) int {
+	t.mu.Lock()
+	defer t.mu.Unlock()
+
+	var ref int
+	if n := len(t.free); n > 0 {
+		ref = t.free[n-1]
+		t.free = t.free[:n-1]
+	} else {
+		if t.next == 0 {
+			t.next = 1
+		}
+		ref = t.next
+		t.next++
+	}
+
+	var chunks []*refChunk[T]
+	if p := t.chunks.Load(); p != nil {
+		chunks = *p
+	}
+	if ref/refChunkSize >= len(chunks) {
+		grown := make([]*refChunk[T], len(chunks)+1)
+		copy(grown, chunks)
+		grown[len(chunks)] = new(refChunk[T])
+		chunks = grown
+		t.chunks.Store(&chunks)
+	}
+	chunks[ref/refChunkSize][ref%refChunkSize].Store(v)
+	return ref
+}
+
+// get returns the object with the given reference, or nil.
+func (t *refTable[T]) get(ref int) *T {
+	p := t.chunks.Load()
+	if p == nil || ref <= 0 || ref/refChunkSize >= len(*p) {
+		return nil
+	}
+	return (*p)[ref/refChunkSize][ref%refChunkSize].Load()
+}
+
+// count returns the number of objects in the table.
+func (t *refTable[T]) count() int {
+	t.mu.Lock()
+	defer t.mu.Unlock()
+
+	n := t.next - len(t.free)
+	if n > 0 {
+		// Reference 0 is never handed out.
+		n--
+	}
+	return n
+}
+
+// remove deletes the object with the given reference, which may be reused.
+func (t *refTable[T]) remove(ref int) {
+	t.mu.Lock()
+	defer t.mu.Unlock()
+
+	p := t.chunks.Load()
+	if p == nil || ref <= 0 || ref/refChunkSize >= len(*p) {
+		return
+	}
+	if (*p)[ref/refChunkSize][ref%refChunkSize].Swap(nil) != nil {
+		t.free = append(t.free, ref)
+	}
+}
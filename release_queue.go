@@ -0,0 +1,94 @@
+package v8go
+
+// #include "context.h"
+// #include "value.h"
+// #include "v8go.h"
+import "C"
+import (
+	"runtime"
+	"sync/atomic"
+	"unsafe"
+)
+
+// releaseQueue is a lock-free stack of objects waiting to be released.
+// Finalizers push onto it from the finalizer goroutine, without holding the
+// isolate lock; the owner drains it on its next call into V8.
+type releaseQueue[T any] struct {
+	head atomic.Pointer[releaseNode[T]]
+}
+
+type releaseNode[T any] struct {
+	v    T
+	next *releaseNode[T]
+}
+
+func (q *releaseQueue[T]) push(v T) {
+	n := &releaseNode[T]{v: v}
+	for {
+		n.next = q.head.Load()
+		if q.head.CompareAndSwap(n.next, n) {
+			return
+		}
+	}
+}
+
+// takeAll empties the queue, returning its objects.
+func (q *releaseQueue[T]) takeAll() []T {
+	if q.head.Load() == nil {
+		return nil
+	}
+	var vs []T
+	for n := q.head.Swap(nil); n != nil; n = n.next {
+		vs = append(vs, n.v)
+	}
+	return vs
+}
+
+// setReleaseFinalizer queues v for release once Go has garbage collected it.
+// Any call into C that is passed v.ptr must therefore keep v reachable until
+// it returns, with runtime.KeepAlive, or another goroutine draining the queue
+// could release the value while the call uses it.
+func (c *Context) setReleaseFinalizer(v *Value) {
+	// The id must be read now: by the time the finalizer runs, the value may
+	// have been released by a value scope or by closing the context.
+	id := (*C.ValueHeader)(unsafe.Pointer(v.ptr)).id
+	runtime.SetFinalizer(v, func(*Value) {
+		c.released.push(id)
+	})
+}
+
+// clearReleaseFinalizer is called when v is released explicitly.
+func (v *Value) clearReleaseFinalizer() {
+	if v.ctx != nil && v.ctx.iso.autoRelease {
+		runtime.SetFinalizer(v, nil)
+	}
+}
+
+// releaseQueued releases all values whose finalizers have run since the last
+// call. Stale ids are ignored by ContextReleaseValueIds.
+func (c *Context) releaseQueued() {
+	ids := c.released.takeAll()
+	if len(ids) == 0 || c.ptr == nil {
+		return
+	}
+	C.ContextReleaseValueIds(c.ptr, &ids[0], C.int(len(ids)))
+}
+
+// releaseTemplates releases all templates whose finalizers have run since the
+// last call. Releasing a template lets V8 collect it, and with it the Go
+// callbacks of its functions.
+func (i *Isolate) releaseTemplates() {
+	ptrs := i.releasedTemplates.takeAll()
+	if len(ptrs) == 0 {
+		return
+	}
+	if i.disposed.Load() {
+		// The isolate, and the templates with it, is gone. Only the wrappers
+		// are left to free.
+		for _, ptr := range ptrs {
+			C.TemplateFreeWrapper(ptr)
+		}
+		return
+	}
+	C.TemplateReleaseMany(i.ptr, &ptrs[0], C.int(len(ptrs)))
+}
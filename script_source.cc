@@ -0,0 +1,252 @@
+#include "script_source.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+
+#include "deps/include/v8-isolate.h"
+#include "deps/include/v8-primitive.h"
+
+using namespace v8;
+
+/********** ScriptSource **********/
+
+// m_scriptSource is source code shared by all isolates that run it. V8 reads
+// it in place through external strings, which each hold a reference.
+struct m_scriptSource {
+  std::atomic<int> refs{1};
+
+  // The source as V8 takes it: Latin-1 in one_byte, or UTF-16 in two_byte.
+  const char* one_byte = nullptr;
+  const uint16_t* two_byte = nullptr;
+  size_t length = 0;
+
+  // The memory to free with the last reference.
+  void* buffer = nullptr;
+  void* mapping = nullptr;
+  size_t mapping_len = 0;
+
+  ~m_scriptSource() {
+    free(buffer);
+    if (mapping != nullptr) {
+      munmap(mapping, mapping_len);
+    }
+  }
+};
+
+class scriptSourceOneByte : public String::ExternalOneByteStringResource {
+ public:
+  explicit scriptSourceOneByte(m_scriptSource* src) : src_(src) {
+    src_->refs.fetch_add(1, std::memory_order_relaxed);
+  }
+  ~scriptSourceOneByte() override { ScriptSourceRelease(src_); }
+
+  const char* data() const override { return src_->one_byte; }
+  size_t length() const override { return src_->length; }
+
+ private:
+  m_scriptSource* src_;
+};
+
+class scriptSourceTwoByte : public String::ExternalStringResource {
+ public:
+  explicit scriptSourceTwoByte(m_scriptSource* src) : src_(src) {
+    src_->refs.fetch_add(1, std::memory_order_relaxed);
+  }
+  ~scriptSourceTwoByte() override { ScriptSourceRelease(src_); }
+
+  const uint16_t* data() const override { return src_->two_byte; }
+  size_t length() const override { return src_->length; }
+
+ private:
+  m_scriptSource* src_;
+};
+
+// decodeUtf8 returns the code point at *p and advances past it. Invalid
+// sequences decode to U+FFFD one byte at a time, as in String::NewFromUtf8.
+static uint32_t decodeUtf8(const uint8_t** p, const uint8_t* end) {
+  const uint8_t* s = *p;
+  uint32_t c = *s;
+  int n;
+  uint32_t min;
+  if (c < 0x80) {
+    *p = s + 1;
+    return c;
+  } else if ((c & 0xE0) == 0xC0) {
+    n = 1;
+    min = 0x80;
+    c &= 0x1F;
+  } else if ((c & 0xF0) == 0xE0) {
+    n = 2;
+    min = 0x800;
+    c &= 0x0F;
+  } else if ((c & 0xF8) == 0xF0) {
+    n = 3;
+    min = 0x10000;
+    c &= 0x07;
+  } else {
+    *p = s + 1;
+    return 0xFFFD;
+  }
+  if (end - s <= n) {
+    *p = s + 1;
+    return 0xFFFD;
+  }
+  for (int i = 1; i <= n; ++i) {
+    if ((s[i] & 0xC0) != 0x80) {
+      *p = s + 1;
+      return 0xFFFD;
+    }
+    c = (c << 6) | (s[i] & 0x3F);
+  }
+  if (c < min || c > 0x10FFFF || (c >= 0xD800 && c <= 0xDFFF)) {
+    *p = s + 1;
+    return 0xFFFD;
+  }
+  *p = s + n + 1;
+  return c;
+}
+
+// setSource points src at the UTF-8 data. ASCII is used in place, and must
+// outlive src. Anything else is converted into a buffer owned by src, as
+// Latin-1 if possible, and UTF-16 otherwise. It returns false if data is used
+// in place.
+static bool setSource(m_scriptSource* src, const char* data, size_t len) {
+  const uint8_t* begin = reinterpret_cast<const uint8_t*>(data);
+  const uint8_t* end = begin + len;
+
+  const uint8_t* p = begin;
+  while (p < end && *p < 0x80) {
+    ++p;
+  }
+  if (p == end) {
+    src->one_byte = data;
+    src->length = len;
+    return false;
+  }
+
+  size_t units = 0;
+  uint32_t max = 0;
+  for (p = begin; p < end;) {
+    uint32_t c = decodeUtf8(&p, end);
+    units += c > 0xFFFF ? 2 : 1;
+    if (c > max) {
+      max = c;
+    }
+  }
+
+  if (max <= 0xFF) {
+    char* out = static_cast<char*>(malloc(units));
+    for (p = begin; p < end;) {
+      *out++ = static_cast<char>(decodeUtf8(&p, end));
+    }
+    src->buffer = out - units;
+    src->one_byte = static_cast<const char*>(src->buffer);
+  } else {
+    uint16_t* out = static_cast<uint16_t*>(malloc(units * sizeof(uint16_t)));
+    for (p = begin; p < end;) {
+      uint32_t c = decodeUtf8(&p, end);
+      if (c > 0xFFFF) {
+        c -= 0x10000;
+        *out++ = static_cast<uint16_t>(0xD800 + (c >> 10));
+        *out++ = static_cast<uint16_t>(0xDC00 + (c & 0x3FF));
+      } else {
+        *out++ = static_cast<uint16_t>(c);
+      }
+    }
+    src->buffer = out - units;
+    src->two_byte = static_cast<const uint16_t*>(src->buffer);
+  }
+  src->length = units;
+  return true;
+}
+
+ScriptSourcePtr NewScriptSource(const char* data, size_t len) {
+  m_scriptSource* src = new m_scriptSource;
+  if (!setSource(src, data, len)) {
+    // ASCII is used in place, but data belongs to Go.
+    src->buffer = malloc(len > 0 ? len : 1);
+    if (len > 0) {
+      memcpy(src->buffer, data, len);
+    }
+    src->one_byte = static_cast<const char*>(src->buffer);
+  }
+  return src;
+}
+
+RtnScriptSource NewScriptSourceFromFile(const char* path) {
+  RtnScriptSource rtn = {};
+
+  int fd = open(path, O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    rtn.error = errno;
+    return rtn;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    rtn.error = errno;
+    close(fd);
+    return rtn;
+  }
+
+  m_scriptSource* src = new m_scriptSource;
+  size_t len = static_cast<size_t>(st.st_size);
+  if (len == 0) {
+    src->one_byte = "";
+    close(fd);
+    rtn.ptr = src;
+    return rtn;
+  }
+
+  void* mapping = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    rtn.error = errno;
+    delete src;
+    return rtn;
+  }
+
+  if (setSource(src, static_cast<const char*>(mapping), len)) {
+    // The source was converted, so the file isn't needed anymore.
+    munmap(mapping, len);
+  } else {
+    src->mapping = mapping;
+    src->mapping_len = len;
+  }
+  rtn.ptr = src;
+  return rtn;
+}
+
+void ScriptSourceRetain(ScriptSourcePtr src) {
+  src->refs.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ScriptSourceRelease(ScriptSourcePtr src) {
+  if (src->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    delete src;
+  }
+}
+
+MaybeLocal<String> ScriptSourceString(Isolate* iso, m_scriptSource* src) {
+  if (src->two_byte != nullptr) {
+    scriptSourceTwoByte* resource = new scriptSourceTwoByte(src);
+    MaybeLocal<String> str = String::NewExternalTwoByte(iso, resource);
+    if (str.IsEmpty()) {
+      delete resource;
+    }
+    return str;
+  }
+  scriptSourceOneByte* resource = new scriptSourceOneByte(src);
+  MaybeLocal<String> str = String::NewExternalOneByte(iso, resource);
+  if (str.IsEmpty()) {
+    delete resource;
+  }
+  return str;
+}
@@ -0,0 +1,86 @@
+package v8go
+
+// #include <stdlib.h>
+// #include "script_source.h"
+import "C"
+import (
+	"os"
+	"runtime"
+	"sync"
+	"syscall"
+	"unsafe"
+)
+
+// ScriptSource is JavaScript source code held outside of any isolate. V8
+// reads it in place through external strings, so running the same large
+// script in many isolates neither copies it into each heap nor keeps it in
+// Go memory. A ScriptSource can be used by any number of isolates
+// concurrently.
+//
+// ASCII sources are used as-is. Other UTF-8 is converted once, when the
+// ScriptSource is created, into the Latin-1 or UTF-16 form V8 expects.
+type ScriptSource struct {
+	mu  sync.Mutex
+	ptr C.ScriptSourcePtr
+}
+
+// NewScriptSource creates a ScriptSource from UTF-8 source code. The bytes are
+// copied, since memory owned by Go can't outlive the call, but only once for
+// all isolates that use the source.
+func NewScriptSource(source []byte) *ScriptSource {
+	var data *C.char
+	if len(source) > 0 {
+		data = (*C.char)(unsafe.Pointer(&source[0]))
+	}
+	return newScriptSource(C.NewScriptSource(data, C.size_t(len(source))))
+}
+
+// NewScriptSourceFromFile creates a ScriptSource from a file of UTF-8 source
+// code. ASCII files are memory-mapped, so their pages are shared with the page
+// cache and between all isolates; the file must not be modified while the
+// ScriptSource is in use.
+func NewScriptSourceFromFile(path string) (*ScriptSource, error) {
+	cPath := C.CString(path)
+	defer C.free(unsafe.Pointer(cPath))
+
+	rtn := C.NewScriptSourceFromFile(cPath)
+	if rtn.ptr == nil {
+		return nil, &os.PathError{Op: "open", Path: path, Err: syscall.Errno(rtn.error)}
+	}
+	return newScriptSource(rtn.ptr), nil
+}
+
+func newScriptSource(ptr C.ScriptSourcePtr) *ScriptSource {
+	s := &ScriptSource{ptr: ptr}
+	runtime.SetFinalizer(s, (*ScriptSource).Release)
+	return s
+}
+
+// Release drops the Go reference to the source. Scripts compiled from it keep
+// the memory alive until V8 disposes of them. Release is safe to call more
+// than once, and is called by the finalizer otherwise.
+func (s *ScriptSource) Release() {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+
+	if s.ptr == nil {
+		return
+	}
+	C.ScriptSourceRelease(s.ptr)
+	s.ptr = nil
+	runtime.SetFinalizer(s, nil)
+}
+
+// retain returns the source with a reference held for the caller, so a
+// concurrent Release can't free it while it is in use. The caller must drop
+// the reference with C.ScriptSourceRelease.
+func (s *ScriptSource) retain() C.ScriptSourcePtr {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+
+	if s.ptr == nil {
+		panic("v8go: ScriptSource used after Release")
+	}
+	C.ScriptSourceRetain(s.ptr)
+	return s.ptr
+}
@@ -0,0 +1,46 @@
+#ifndef V8GO_SCRIPT_SOURCE_H
+#define V8GO_SCRIPT_SOURCE_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+
+#include "deps/include/v8-local-handle.h"
+
+namespace v8 {
+class Isolate;
+class String;
+}  // namespace v8
+
+typedef struct m_scriptSource m_scriptSource;
+
+// ScriptSourceString creates an external string backed by the source. The
+// string holds a reference to the source until V8 disposes of it.
+extern v8::MaybeLocal<v8::String> ScriptSourceString(v8::Isolate* iso,
+                                                     m_scriptSource* src);
+
+extern "C" {
+#else
+
+typedef struct m_scriptSource m_scriptSource;
+
+#endif
+
+typedef m_scriptSource* ScriptSourcePtr;
+
+typedef struct {
+  ScriptSourcePtr ptr;
+  int error;
+} RtnScriptSource;
+
+extern ScriptSourcePtr NewScriptSource(const char* data, size_t len);
+extern RtnScriptSource NewScriptSourceFromFile(const char* path);
+// ScriptSourceRetain and ScriptSourceRelease add and drop a reference. The
+// source is freed when the last reference is dropped.
+extern void ScriptSourceRetain(ScriptSourcePtr src);
+extern void ScriptSourceRelease(ScriptSourcePtr src);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+#endif
@@ -0,0 +1,101 @@
+package v8go_test
+
+import (
+	"errors"
+	"os"
+	"path/filepath"
+	"sync"
+	"testing"
+
+	v8 "github.com/tommie/v8go"
+)
+
+func TestScriptSource(t *testing.T) {
+	t.Parallel()
+
+	path := filepath.Join(t.TempDir(), "script.js")
+	fatalIf(t, os.WriteFile(path, []byte(`"from " + "file"`), 0o644))
+	file, err := v8.NewScriptSourceFromFile(path)
+	fatalIf(t, err)
+	defer file.Release()
+
+	tcs := []struct {
+		name   string
+		source *v8.ScriptSource
+		want   string
+	}{
+		{"ascii", v8.NewScriptSource([]byte(`"a" + "b"`)), "ab"},
+		{"latin1", v8.NewScriptSource([]byte(`"caf" + "é"`)), "café"},
+		{"utf16", v8.NewScriptSource([]byte(`"😀" + "€"`)), "😀€"},
+		{"empty", v8.NewScriptSource(nil), "undefined"},
+		{"file", file, "from file"},
+	}
+	for _, tc := range tcs {
+		tc := tc
+		t.Run(tc.name, func(t *testing.T) {
+			// Each source is shared by two isolates.
+			for i := 0; i < 2; i++ {
+				ctx := v8.NewContext()
+				val, err := ctx.RunScriptSource(tc.source, "source.js")
+				fatalIf(t, err)
+				if s := val.String(); s != tc.want {
+					t.Errorf("expected %q, got %q", tc.want, s)
+				}
+
+				us, err := ctx.Isolate().CompileUnboundScriptSource(tc.source, "source.js", v8.CompileOptions{})
+				fatalIf(t, err)
+				val, err = us.Run(ctx)
+				fatalIf(t, err)
+				if s := val.String(); s != tc.want {
+					t.Errorf("expected %q from unbound script, got %q", tc.want, s)
+				}
+				ctx.Close()
+				ctx.Isolate().Dispose()
+			}
+		})
+	}
+
+	if _, err := v8.NewScriptSourceFromFile(filepath.Join(t.TempDir(), "missing.js")); !errors.Is(err, os.ErrNotExist) {
+		t.Errorf("expected a missing file to fail with ErrNotExist, got %v", err)
+	}
+
+	src := v8.NewScriptSource([]byte(`1`))
+	src.Release()
+	src.Release()
+}
+
+func TestScriptSourceConcurrentRelease(t *testing.T) {
+	t.Parallel()
+
+	src := v8.NewScriptSource([]byte("'x'.repeat(1000).length"))
+
+	// Runs racing with Release either see the source, or panic because it
+	// is gone; they must never use freed memory.
+	var wg sync.WaitGroup
+	for i := 0; i < 4; i++ {
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			iso := v8.NewIsolate()
+			defer iso.Dispose()
+			ctx := v8.NewContext(iso)
+			defer ctx.Close()
+			for j := 0; j < 50; j++ {
+				var val *v8.Value
+				var err error
+				if recoverPanic(func() { val, err = ctx.RunScriptSource(src, "src.js") }) != nil {
+					return
+				}
+				if err != nil {
+					t.Error(err)
+					return
+				}
+				if n := val.Int32(); n != 1000 {
+					t.Errorf("expected 1000, got %d", n)
+				}
+			}
+		}()
+	}
+	src.Release()
+	wg.Wait()
+}
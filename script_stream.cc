@@ -0,0 +1,195 @@
+#include "script_stream.h"
+
+#include <string.h>
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "context.h"
+#include "deps/include/v8-context.h"
+#include "deps/include/v8-platform.h"
+#include "deps/include/v8-script.h"
+#include "isolate-macros.h"
+
+using namespace v8;
+
+// Defined in isolate.cc.
+extern std::unique_ptr<Platform> default_platform;
+
+/********** ScriptStream **********/
+
+// goSourceStream hands the chunks pushed by Go to V8's parser, which reads
+// them on a worker thread. Push blocks while kMaxChunks are queued, so a
+// worker that falls behind slows down the reader instead of buffering the
+// whole source.
+class goSourceStream : public ScriptCompiler::ExternalSourceStream {
+ public:
+  static const size_t kMaxChunks = 16;
+
+  ~goSourceStream() override {
+    for (auto& chunk : chunks_) {
+      delete[] chunk.first;
+    }
+  }
+
+  size_t GetMoreData(const uint8_t** src) override {
+    std::unique_lock<std::mutex> lock(mu_);
+    cond_.wait(lock, [this] { return !chunks_.empty() || finished_; });
+    if (chunks_.empty()) {
+      *src = nullptr;
+      return 0;
+    }
+    std::pair<uint8_t*, size_t> chunk = chunks_.front();
+    chunks_.pop_front();
+    cond_.notify_all();
+    // V8 takes ownership of the chunk.
+    *src = chunk.first;
+    return chunk.second;
+  }
+
+  void Push(uint8_t* data, size_t len) {
+    std::unique_lock<std::mutex> lock(mu_);
+    cond_.wait(lock, [this] { return chunks_.size() < kMaxChunks || closed_; });
+    if (closed_) {
+      delete[] data;
+      return;
+    }
+    chunks_.emplace_back(data, len);
+    cond_.notify_all();
+  }
+
+  void Finish() {
+    std::lock_guard<std::mutex> lock(mu_);
+    finished_ = true;
+    cond_.notify_all();
+  }
+
+  // Close drops the chunks pushed from now on. It is called once V8 has
+  // stopped reading, which it may do before the end on a syntax error.
+  void Close() {
+    std::lock_guard<std::mutex> lock(mu_);
+    closed_ = true;
+    cond_.notify_all();
+  }
+
+ private:
+  std::mutex mu_;
+  std::condition_variable cond_;
+  std::deque<std::pair<uint8_t*, size_t>> chunks_;
+  bool finished_ = false;
+  bool closed_ = false;
+};
+
+struct m_scriptStream {
+  Isolate* iso;
+  // Owned by source.
+  goSourceStream* stream;
+  std::unique_ptr<ScriptCompiler::StreamedSource> source;
+  std::unique_ptr<ScriptCompiler::ScriptStreamingTask> task;
+  // V8 doesn't keep the source while streaming, but needs it to compile.
+  std::string text;
+
+  std::mutex mu;
+  std::condition_variable cond;
+  bool parsed = false;
+
+  void Wait() {
+    std::unique_lock<std::mutex> lock(mu);
+    cond.wait(lock, [this] { return parsed; });
+  }
+};
+
+// scriptStreamTask runs V8's streaming task on a platform worker thread.
+class scriptStreamTask : public Task {
+ public:
+  explicit scriptStreamTask(m_scriptStream* s) : s_(s) {}
+
+  void Run() override {
+    s_->task->Run();
+    s_->stream->Close();
+    std::lock_guard<std::mutex> lock(s_->mu);
+    s_->parsed = true;
+    s_->cond.notify_all();
+  }
+
+ private:
+  m_scriptStream* s_;
+};
+
+ScriptStreamPtr NewScriptStream(IsolatePtr iso) {
+  ISOLATE_SCOPE(iso);
+
+  m_scriptStream* s = new m_scriptStream;
+  s->iso = iso;
+  s->stream = new goSourceStream;
+  s->source = std::make_unique<ScriptCompiler::StreamedSource>(
+      std::unique_ptr<ScriptCompiler::ExternalSourceStream>(s->stream),
+      ScriptCompiler::StreamedSource::UTF8);
+  s->task.reset(ScriptCompiler::StartStreaming(iso, s->source.get()));
+  default_platform->PostTaskOnWorkerThread(
+      TaskPriority::kUserVisible, std::make_unique<scriptStreamTask>(s));
+  return s;
+}
+
+void ScriptStreamPush(ScriptStreamPtr s, const char* data, int len) {
+  // An empty chunk would end the stream.
+  if (len == 0) {
+    return;
+  }
+  s->text.append(data, len);
+  uint8_t* chunk = new uint8_t[len];
+  memcpy(chunk, data, len);
+  s->stream->Push(chunk, len);
+}
+
+void ScriptStreamFinish(ScriptStreamPtr s) {
+  s->stream->Finish();
+}
+
+RtnUnboundScript ScriptStreamCompile(ScriptStreamPtr s,
+                                     const char* o,
+                                     int o_len) {
+  s->Wait();
+
+  Isolate* iso = s->iso;
+  ISOLATE_SCOPE(iso);
+  INTERNAL_CONTEXT(iso);
+  TryCatch try_catch(iso);
+  Local<Context> local_ctx = ctx->ptr.Get(iso);
+  Context::Scope context_scope(local_ctx);
+
+  RtnUnboundScript rtn = {};
+
+  Local<String> src, ogn;
+  if (!String::NewFromUtf8(iso, s->text.data(), NewStringType::kNormal,
+                           s->text.size())
+           .ToLocal(&src) ||
+      !String::NewFromUtf8(iso, o, NewStringType::kNormal, o_len)
+           .ToLocal(&ogn)) {
+    rtn.error = ExceptionError(try_catch, iso, local_ctx);
+    return rtn;
+  }
+
+  ScriptOrigin script_origin(ogn);
+  Local<Script> script;
+  if (!ScriptCompiler::Compile(local_ctx, s->source.get(), src, script_origin)
+           .ToLocal(&script)) {
+    rtn.error = ExceptionError(try_catch, iso, local_ctx);
+    return rtn;
+  }
+
+  rtn.ptr = tracked_unbound_script(ctx, script->GetUnboundScript());
+  return rtn;
+}
+
+void ScriptStreamFree(ScriptStreamPtr s) {
+  // The worker would never finish parsing if the source wasn't ended, e.g.
+  // when reading it panicked.
+  s->stream->Finish();
+  s->Wait();
+  delete s;
+}
@@ -0,0 +1,46 @@
+package v8go
+
+// #include "script_stream.h"
+import "C"
+import (
+	"errors"
+	"io"
+	"unsafe"
+)
+
+// scriptStreamChunkSize is how much CompileUnboundScriptReader reads before
+// handing the source to V8. Full chunks also keep UTF-8 characters from being
+// split over more than two chunks, which V8 doesn't support.
+const scriptStreamChunkSize = 64 << 10
+
+// CompileUnboundScriptReader is like CompileUnboundScript, but reads the UTF-8
+// source from r while V8 parses it on a worker thread. The isolate is only
+// locked to start streaming and for the final compilation, so it stays
+// available to other goroutines while the source is read and parsed. Errors
+// from r are returned as is; compile errors will be of type `JSError`.
+func (i *Isolate) CompileUnboundScriptReader(r io.Reader, origin string) (*UnboundScript, error) {
+	stream := C.NewScriptStream(i.ptr)
+	defer C.ScriptStreamFree(stream)
+	// If r panics, the worker must see the end of the source before Free
+	// waits for it.
+	defer C.ScriptStreamFinish(stream)
+
+	buf := make([]byte, scriptStreamChunkSize)
+	for {
+		n, err := io.ReadFull(r, buf)
+		if n > 0 {
+			C.ScriptStreamPush(stream, (*C.char)(unsafe.Pointer(&buf[0])), C.int(n))
+		}
+		if errors.Is(err, io.EOF) || errors.Is(err, io.ErrUnexpectedEOF) {
+			break
+		}
+		if err != nil {
+			return nil, err
+		}
+	}
+	C.ScriptStreamFinish(stream)
+
+	cOrigin, originLen := cStringN(origin)
+	rtn := C.ScriptStreamCompile(stream, cOrigin, originLen)
+	return i.unboundScriptResult(rtn, CompileOptions{})
+}
@@ -0,0 +1,32 @@
+#ifndef V8GO_SCRIPT_STREAM_H
+#define V8GO_SCRIPT_STREAM_H
+
+#include "unbound_script.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct m_scriptStream m_scriptStream;
+typedef m_scriptStream* ScriptStreamPtr;
+
+// NewScriptStream starts parsing a script on a platform worker thread. The
+// source is passed in chunks with ScriptStreamPush, and ended by
+// ScriptStreamFinish.
+extern ScriptStreamPtr NewScriptStream(IsolatePtr iso_ptr);
+extern void ScriptStreamPush(ScriptStreamPtr stream, const char* data, int len);
+// ScriptStreamFinish ends the source. Calling it again has no effect.
+extern void ScriptStreamFinish(ScriptStreamPtr stream);
+// ScriptStreamCompile waits for the worker to finish parsing, and compiles the
+// result. It must only be called after ScriptStreamFinish.
+extern RtnUnboundScript ScriptStreamCompile(ScriptStreamPtr stream,
+                                            const char* origin,
+                                            int origin_len);
+// ScriptStreamFree ends the source if it hasn't been, waits for the worker to
+// finish, and frees the stream.
+extern void ScriptStreamFree(ScriptStreamPtr stream);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,71 @@
+package v8go_test
+
+import (
+	"errors"
+	"fmt"
+	"io"
+	"strings"
+	"testing"
+	"testing/iotest"
+
+	v8 "github.com/tommie/v8go"
+)
+
+func TestIsolateCompileUnboundScriptReader(t *testing.T) {
+	t.Parallel()
+
+	iso := v8.NewIsolate()
+	defer iso.Dispose()
+	ctx := v8.NewContext(iso)
+	defer ctx.Close()
+
+	// Large enough for several chunks, with characters split between them.
+	var sb strings.Builder
+	sb.WriteString("let s = '';\n")
+	for i := 0; i < 20000; i++ {
+		fmt.Fprintf(&sb, "s += 'é😀%d';\n", i%10)
+	}
+	sb.WriteString("s.length")
+
+	us, err := iso.CompileUnboundScriptReader(iotest.HalfReader(strings.NewReader(sb.String())), "stream.js")
+	fatalIf(t, err)
+	val, err := us.Run(ctx)
+	fatalIf(t, err)
+	if n := val.Int32(); n != 20000*4 {
+		t.Errorf("expected length %d, got %d", 20000*4, n)
+	}
+
+	if _, err := iso.CompileUnboundScriptReader(strings.NewReader(`(`), "broken.js"); err == nil {
+		t.Error("expected a syntax error")
+	} else if _, ok := err.(*v8.JSError); !ok {
+		t.Errorf("expected a JSError, got %T", err)
+	}
+
+	readErr := errors.New("read failed")
+	r := io.MultiReader(strings.NewReader(`1 + `), iotest.ErrReader(readErr))
+	if _, err := iso.CompileUnboundScriptReader(r, "failing.js"); !errors.Is(err, readErr) {
+		t.Errorf("expected the read error, got %v", err)
+	}
+}
+
+type panicReader struct{}
+
+func (panicReader) Read([]byte) (int, error) {
+	panic("read panicked")
+}
+
+func TestIsolateCompileUnboundScriptReaderPanic(t *testing.T) {
+	t.Parallel()
+
+	iso := v8.NewIsolate()
+	defer iso.Dispose()
+
+	// The panic must unwind instead of waiting for a worker that never sees
+	// the end of the source.
+	defer func() {
+		if recover() == nil {
+			t.Error("expected the reader's panic to propagate")
+		}
+	}()
+	iso.CompileUnboundScriptReader(io.MultiReader(strings.NewReader(`1 + `), panicReader{}), "panic.js")
+}
@@ -0,0 +1,145 @@
+package v8go
+
+import (
+	"container/list"
+	"crypto/sha256"
+	"sync"
+	"sync/atomic"
+)
+
+// SharedCodeCacheStats describes the use of the process-wide code cache.
+type SharedCodeCacheStats struct {
+	// Hits counts compilations that consumed a cached code cache, and Rejects
+	// those where V8 rejected it and compiled the source instead.
+	Hits    uint64
+	Rejects uint64
+	Misses  uint64
+	// Evictions counts code caches dropped to stay within the byte limit.
+	Evictions uint64
+	Entries   int
+	Bytes     int
+}
+
+// sharedCodeCacheInUse is the cache Isolate.CompileUnboundScript uses, or nil.
+var sharedCodeCacheInUse atomic.Pointer[sharedCodeCache]
+
+// EnableSharedCodeCache makes Isolate.CompileUnboundScript share code caches
+// between all isolates of the process. The first isolate to compile a source
+// stores V8's code cache for it, and later isolates deserialize that instead
+// of compiling the source again. The least recently used code caches are
+// evicted once they add up to more than maxBytes. A maxBytes of zero or less
+// disables the cache and drops its contents.
+func EnableSharedCodeCache(maxBytes int) {
+	if maxBytes <= 0 {
+		sharedCodeCacheInUse.Store(nil)
+		return
+	}
+	sharedCodeCacheInUse.Store(&sharedCodeCache{
+		maxBytes: maxBytes,
+		entries:  make(map[[sha256.Size]byte]*list.Element),
+	})
+}
+
+// GetSharedCodeCacheStats returns the counters of the cache enabled by
+// EnableSharedCodeCache. They are all zero if the cache isn't enabled.
+func GetSharedCodeCacheStats() SharedCodeCacheStats {
+	c := sharedCodeCacheInUse.Load()
+	if c == nil {
+		return SharedCodeCacheStats{}
+	}
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	stats := c.stats
+	stats.Entries = c.lru.Len()
+	stats.Bytes = c.bytes
+	return stats
+}
+
+// sharedCodeCache maps the SHA-256 of script sources to V8 code caches. The
+// cached bytes are never modified, so isolates can read them without holding
+// the lock.
+type sharedCodeCache struct {
+	mu       sync.Mutex
+	maxBytes int
+	bytes    int
+	// Most recently used first.
+	lru     list.List
+	entries map[[sha256.Size]byte]*list.Element
+	stats   SharedCodeCacheStats
+}
+
+type sharedCodeCacheEntry struct {
+	key  [sha256.Size]byte
+	data []byte
+}
+
+func (c *sharedCodeCache) compile(iso *Isolate, source, origin string) (*UnboundScript, error) {
+	key := sha256.Sum256([]byte(source))
+
+	if data := c.get(key); data != nil {
+		cached := &CompilerCachedData{Bytes: data}
+		us, err := iso.compileUnboundScript(source, origin, CompileOptions{CachedData: cached})
+		if err != nil {
+			return nil, err
+		}
+		c.mu.Lock()
+		if cached.Rejected {
+			c.stats.Rejects++
+		} else {
+			c.stats.Hits++
+		}
+		c.mu.Unlock()
+		if !cached.Rejected {
+			return us, nil
+		}
+		// V8 compiled the source instead, so the code cache is replaced.
+		c.put(key, us.CreateCodeCache().Bytes)
+		return us, nil
+	}
+
+	us, err := iso.compileUnboundScript(source, origin, CompileOptions{})
+	if err != nil {
+		return nil, err
+	}
+	c.mu.Lock()
+	c.stats.Misses++
+	c.mu.Unlock()
+	c.put(key, us.CreateCodeCache().Bytes)
+	return us, nil
+}
+
+func (c *sharedCodeCache) get(key [sha256.Size]byte) []byte {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+
+	e := c.entries[key]
+	if e == nil {
+		return nil
+	}
+	c.lru.MoveToFront(e)
+	return e.Value.(*sharedCodeCacheEntry).data
+}
+
+func (c *sharedCodeCache) put(key [sha256.Size]byte, data []byte) {
+	if len(data) == 0 || len(data) > c.maxBytes {
+		return
+	}
+	c.mu.Lock()
+	defer c.mu.Unlock()
+
+	if e := c.entries[key]; e != nil {
+		c.remove(e)
+	}
+	c.entries[key] = c.lru.PushFront(&sharedCodeCacheEntry{key: key, data: data})
+	c.bytes += len(data)
+	for c.bytes > c.maxBytes {
+		c.remove(c.lru.Back())
+		c.stats.Evictions++
+	}
+}
+
+func (c *sharedCodeCache) remove(e *list.Element) {
+	entry := c.lru.Remove(e).(*sharedCodeCacheEntry)
+	delete(c.entries, entry.key)
+	c.bytes -= len(entry.data)
+}
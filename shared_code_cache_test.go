@@ -0,0 +1,49 @@
+package v8go_test
+
+import (
+	"testing"
+
+	v8 "github.com/tommie/v8go"
+)
+
+// The shared code cache is process-wide, so this test doesn't run in parallel
+// with others.
+func TestSharedCodeCache(t *testing.T) {
+	v8.EnableSharedCodeCache(1 << 20)
+	defer v8.EnableSharedCodeCache(0)
+
+	const source = `function mul(a, b) { return a * b }; mul(6, 7)`
+	for i := 0; i < 3; i++ {
+		iso := v8.NewIsolate()
+		us, err := iso.CompileUnboundScript(source, "mul.js", v8.CompileOptions{})
+		fatalIf(t, err)
+		ctx := v8.NewContext(iso)
+		val, err := us.Run(ctx)
+		fatalIf(t, err)
+		if val.Int32() != 42 {
+			t.Errorf("expected 42, got %v", val)
+		}
+		ctx.Close()
+		iso.Dispose()
+	}
+
+	stats := v8.GetSharedCodeCacheStats()
+	if stats.Misses != 1 || stats.Hits != 2 || stats.Rejects != 0 || stats.Entries != 1 || stats.Bytes == 0 {
+		t.Errorf("unexpected stats: %+v", stats)
+	}
+
+	// A cache too small for any code cache keeps nothing.
+	v8.EnableSharedCodeCache(1)
+	iso := v8.NewIsolate()
+	defer iso.Dispose()
+	_, err := iso.CompileUnboundScript(source, "mul.js", v8.CompileOptions{})
+	fatalIf(t, err)
+	if stats := v8.GetSharedCodeCacheStats(); stats.Misses != 1 || stats.Entries != 0 {
+		t.Errorf("unexpected stats for a tiny cache: %+v", stats)
+	}
+
+	v8.EnableSharedCodeCache(0)
+	if stats := v8.GetSharedCodeCacheStats(); stats != (v8.SharedCodeCacheStats{}) {
+		t.Errorf("expected no stats once disabled, got %+v", stats)
+	}
+}
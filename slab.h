@@ -0,0 +1,64 @@
+#ifndef V8GO_SLAB_H
+#define V8GO_SLAB_H
+
+#include <stddef.h>
+
+#include <new>
+#include <utility>
+#include <vector>
+
+// m_slab carves objects of type T out of fixed-size chunks instead of
+// allocating each one on the heap. Deleted objects are put on a free list and
+// reused by later allocations. The chunks are only returned to the system when
+// the slab itself is destroyed, which lets an owner release everything it
+// allocated in bulk. Objects still alive at that point are not destroyed, so
+// the owner must Delete them first if T has a non-trivial destructor.
+//
+// m_slab is not thread-safe; callers are expected to hold the isolate lock.
+template <typename T, size_t ChunkSize = 128>
+class m_slab {
+ public:
+  m_slab() = default;
+  m_slab(const m_slab&) = delete;
+  m_slab& operator=(const m_slab&) = delete;
+
+  ~m_slab() {
+    for (slot* chunk : chunks_) {
+      delete[] chunk;
+    }
+  }
+
+  template <typename... Args>
+  T* New(Args&&... args) {
+    slot* s = free_;
+    if (s != nullptr) {
+      free_ = s->next;
+    } else {
+      if (used_ == ChunkSize) {
+        chunks_.push_back(new slot[ChunkSize]);
+        used_ = 0;
+      }
+      s = &chunks_.back()[used_++];
+    }
+    return new (s->storage) T(std::forward<Args>(args)...);
+  }
+
+  void Delete(T* obj) {
+    obj->~T();
+    slot* s = reinterpret_cast<slot*>(obj);
+    s->next = free_;
+    free_ = s;
+  }
+
+ private:
+  union slot {
+    slot* next;
+    alignas(T) unsigned char storage[sizeof(T)];
+  };
+
+  std::vector<slot*> chunks_;
+  slot* free_ = nullptr;
+  size_t used_ = ChunkSize;
+};
+
+#endif
@@ -47,12 +47,7 @@ ValuePtr BuiltinSymbol(IsolatePtr iso, SymbolIndex idx) {
     default:
       return nullptr;
   }
-  m_value* val = new m_value;
-  val->id = 0;
-  val->iso = iso;
-  val->ctx = ctx;
-  val->ptr = Global<Value>(iso, sym);
-  return tracked_value(ctx, val);
+  return tracked_value(ctx, sym);
 }
 
 const char* SymbolDescription(ValuePtr ptr) {
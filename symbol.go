@@ -6,6 +6,7 @@ package v8go
 
 import (
 	"fmt"
+	"runtime"
 	"unsafe"
 
 	// #include <stdlib.h>
@@ -49,6 +50,7 @@ func symbolByIndex(iso *Isolate, idx C.SymbolIndex) *Symbol {
 // e.g. "Symbol.asyncIterator".
 func (sym *Symbol) Description() string {
 	s := C.SymbolDescription(sym.Value.ptr)
+	runtime.KeepAlive(sym)
 	defer C.free(unsafe.Pointer(s))
 	return C.GoString(s)
 }
@@ -12,7 +12,6 @@ import (
 	"fmt"
 	"math/big"
 	"runtime"
-	"unsafe"
 )
 
 type template struct {
@@ -25,8 +24,7 @@ type template struct {
 // If the value passed is a Go supported primitive (string, int32, uint32, int64, uint64, float64, big.Int)
 // then a value will be created and set as the value property.
 func (t *template) Set(name string, val interface{}, attributes ...PropertyAttribute) error {
-	cname := C.CString(name)
-	defer C.free(unsafe.Pointer(cname))
+	cname, nameLen := cStringN(name)
 
 	var attrs PropertyAttribute
 	for _, a := range attributes {
@@ -39,18 +37,19 @@ func (t *template) Set(name string, val interface{}, attributes ...PropertyAttri
 		if err != nil {
 			return fmt.Errorf("v8go: unable to create new value: %v", err)
 		}
-		C.TemplateSetValue(t.ptr, cname, newVal.ptr, C.int(attrs))
+		C.TemplateSetValue(t.ptr, cname, nameLen, newVal.ptr, C.int(attrs))
 	case *ObjectTemplate:
-		C.TemplateSetTemplate(t.ptr, cname, v.ptr, C.int(attrs))
+		C.TemplateSetTemplate(t.ptr, cname, nameLen, v.ptr, C.int(attrs))
 		runtime.KeepAlive(v)
 	case *FunctionTemplate:
-		C.TemplateSetTemplate(t.ptr, cname, v.ptr, C.int(attrs))
+		C.TemplateSetTemplate(t.ptr, cname, nameLen, v.ptr, C.int(attrs))
 		runtime.KeepAlive(v)
 	case *Value:
 		if v.IsObject() || v.IsExternal() {
 			return errors.New("v8go: unsupported property: value type must be a primitive or use a template")
 		}
-		C.TemplateSetValue(t.ptr, cname, v.ptr, C.int(attrs))
+		C.TemplateSetValue(t.ptr, cname, nameLen, v.ptr, C.int(attrs))
+		runtime.KeepAlive(v)
 	default:
 		return fmt.Errorf("v8go: unsupported property type `%T`, must be one of string, int32, uint32, int64, uint64, float64, *big.Int, *v8go.Value, *v8go.ObjectTemplate or *v8go.FunctionTemplate", v)
 	}
@@ -95,6 +94,7 @@ func (t *template) SetSymbol(key *Symbol, val interface{}, attributes ...Propert
 		if C.TemplateSetAnyValue(t.ptr, key.ptr, v.ptr, C.int(attrs)) == 0 {
 			return fmt.Errorf("v8go: unable to set property for symbol %v", key)
 		}
+		runtime.KeepAlive(v)
 	default:
 		return fmt.Errorf("v8go: unsupported property type `%T`, must be one of string, int32, uint32, int64, uint64, float64, *big.Int, *v8go.Value, *v8go.ObjectTemplate or *v8go.FunctionTemplate", v)
 	}
@@ -105,8 +105,12 @@ func (t *template) SetSymbol(key *Symbol, val interface{}, attributes ...Propert
 
 func (t *template) finalizer() {
 	// Using v8::PersistentBase::Reset() wouldn't be thread-safe to do from
-	// this finalizer goroutine so just free the wrapper and let the template
-	// itself get cleaned up when the isolate is disposed.
-	C.TemplateFreeWrapper(t.ptr)
+	// this finalizer goroutine, so the template is queued for the isolate's
+	// owner to release on its next call into V8. Once the isolate is
+	// disposed, only the wrapper is left to free.
+	t.iso.releasedTemplates.push(t.ptr)
+	if t.iso.disposed.Load() {
+		t.iso.releaseTemplates()
+	}
 	t.ptr = nil
 }
@@ -27,6 +27,14 @@ ScriptCompilerCachedData* UnboundScriptCreateCodeCache(
   return cd;
 }
 
+int ScriptCompilerCachedDataCheck(IsolatePtr iso,
+                                  const uint8_t* data,
+                                  int length) {
+  Locker locker(iso);
+  ScriptCompiler::CachedData cached_data(data, length);
+  return cached_data.CompatibilityCheck(iso);
+}
+
 void ScriptCompilerCachedDataDelete(ScriptCompilerCachedData* cached_data) {
   delete cached_data->ptr;
   delete cached_data;
@@ -47,12 +55,6 @@ RtnValue UnboundScriptRun(ContextPtr ctx, UnboundScriptPtr us_ptr) {
     rtn.error = ExceptionError(try_catch, iso, local_ctx);
     return rtn;
   }
-  m_value* val = new m_value;
-  val->id = 0;
-  val->iso = iso;
-  val->ctx = ctx;
-  val->ptr = Global<Value>(iso, result);
-
-  rtn.value = tracked_value(ctx, val);
+  rtn.value = tracked_value(ctx, result);
   return rtn;
 }
@@ -21,6 +21,11 @@ struct m_unboundScript {
   v8::Persistent<v8::UnboundScript> ptr;
 };
 
+typedef struct m_ctx m_ctx;
+extern m_unboundScript* tracked_unbound_script(
+    m_ctx* ctx,
+    v8::Local<v8::UnboundScript> unbound_script);
+
 typedef v8::ScriptCompiler::CachedData* ScriptCompilerCachedDataPtr;
 typedef v8::Isolate v8Isolate;
 
@@ -57,6 +62,12 @@ typedef struct {
 extern ScriptCompilerCachedData* UnboundScriptCreateCodeCache(
     IsolatePtr iso_ptr,
     UnboundScriptPtr us_ptr);
+// ScriptCompilerCachedDataCheck returns whether a code cache can be used by
+// the isolate, as a ScriptCompiler::CachedData::CompatibilityCheckResult. Zero
+// means it can.
+extern int ScriptCompilerCachedDataCheck(IsolatePtr iso_ptr,
+                                         const uint8_t* data,
+                                         int length);
 extern void ScriptCompilerCachedDataDelete(
     ScriptCompilerCachedData* cached_data);
 extern RtnValue UnboundScriptRun(ContextPtr ctx_ptr, UnboundScriptPtr us_ptr);
@@ -23,7 +23,10 @@ const int ScriptCompilerNoCompileOptions = ScriptCompiler::kNoCompileOptions;
 const int ScriptCompilerConsumeCodeCache = ScriptCompiler::kConsumeCodeCache;
 const int ScriptCompilerEagerCompile = ScriptCompiler::kEagerCompile;
 
-m_unboundScript* tracked_unbound_script(m_ctx* ctx, m_unboundScript* us) {
+m_unboundScript* tracked_unbound_script(m_ctx* ctx,
+                                        Local<UnboundScript> unbound_script) {
+  m_unboundScript* us = ctx->unboundScriptSlab.New();
+  us->ptr.Reset(ctx->iso, unbound_script);
   ctx->unboundScripts.push_back(us);
 
   return us;
@@ -37,21 +40,27 @@ extern "C" {
   ISOLATE_SCOPE(iso);                       \
   m_ctx* ctx = isolateInternalContext(iso);
 
-RtnUnboundScript IsolateCompileUnboundScript(IsolatePtr iso,
-                                             const char* s,
+// compileUnboundScript compiles the source, which may be empty if creating it
+// failed.
+static RtnUnboundScript compileUnboundScript(IsolatePtr iso,
+                                             m_ctx* ctx,
+                                             TryCatch& try_catch,
+                                             MaybeLocal<String> maybeSrc,
                                              const char* o,
+                                             int o_len,
                                              CompileOptions opts) {
-  ISOLATE_SCOPE_INTERNAL_CONTEXT(iso);
-  TryCatch try_catch(iso);
   Local<Context> local_ctx = ctx->ptr.Get(iso);
   Context::Scope context_scope(local_ctx);
 
   RtnUnboundScript rtn = {};
 
-  Local<String> src =
-      String::NewFromUtf8(iso, s, NewStringType::kNormal).ToLocalChecked();
-  Local<String> ogn =
-      String::NewFromUtf8(iso, o, NewStringType::kNormal).ToLocalChecked();
+  Local<String> src, ogn;
+  if (!maybeSrc.ToLocal(&src) ||
+      !String::NewFromUtf8(iso, o, NewStringType::kNormal, o_len)
+           .ToLocal(&ogn)) {
+    rtn.error = ExceptionError(try_catch, iso, local_ctx);
+    return rtn;
+  }
 
   ScriptCompiler::CompileOptions option =
       static_cast<ScriptCompiler::CompileOptions>(opts.compileOption);
@@ -78,12 +87,35 @@ RtnUnboundScript IsolateCompileUnboundScript(IsolatePtr iso,
     rtn.cachedDataRejected = cached_data->rejected;
   }
 
-  m_unboundScript* us = new m_unboundScript;
-  us->ptr.Reset(iso, unbound_script);
-  rtn.ptr = tracked_unbound_script(ctx, us);
+  rtn.ptr = tracked_unbound_script(ctx, unbound_script);
   return rtn;
 }
 
+RtnUnboundScript IsolateCompileUnboundScript(IsolatePtr iso,
+                                             const char* s,
+                                             int s_len,
+                                             const char* o,
+                                             int o_len,
+                                             CompileOptions opts) {
+  ISOLATE_SCOPE_INTERNAL_CONTEXT(iso);
+  TryCatch try_catch(iso);
+  return compileUnboundScript(
+      iso, ctx, try_catch,
+      String::NewFromUtf8(iso, s, NewStringType::kNormal, s_len), o, o_len,
+      opts);
+}
+
+RtnUnboundScript IsolateCompileUnboundScriptSource(IsolatePtr iso,
+                                                   ScriptSourcePtr s,
+                                                   const char* o,
+                                                   int o_len,
+                                                   CompileOptions opts) {
+  ISOLATE_SCOPE_INTERNAL_CONTEXT(iso);
+  TryCatch try_catch(iso);
+  return compileUnboundScript(iso, ctx, try_catch, ScriptSourceString(iso, s),
+                              o, o_len, opts);
+}
+
 /********** Exceptions & Errors **********/
 
 ValuePtr IsolateThrowException(IsolatePtr iso, ValuePtr value) {
@@ -92,13 +124,7 @@ ValuePtr IsolateThrowException(IsolatePtr iso, ValuePtr value) {
 
   Local<Value> throw_ret_val = iso->ThrowException(value->ptr.Get(iso));
 
-  m_value* new_val = new m_value;
-  new_val->id = 0;
-  new_val->iso = iso;
-  new_val->ctx = ctx;
-  new_val->ptr = Global<Value>(iso, throw_ret_val);
-
-  return tracked_value(ctx, new_val);
+  return tracked_value(ctx, throw_ret_val);
 }
 
 /********** CpuProfiler **********/
@@ -124,7 +150,9 @@ void CPUProfilerDispose(CPUProfiler* profiler) {
   delete profiler;
 }
 
-void CPUProfilerStartProfiling(CPUProfiler* profiler, const char* title) {
+void CPUProfilerStartProfiling(CPUProfiler* profiler,
+                               const char* title,
+                               int title_len) {
   if (profiler->iso == nullptr) {
     return;
   }
@@ -133,9 +161,10 @@ void CPUProfilerStartProfiling(CPUProfiler* profiler, const char* title) {
   Isolate::Scope isolate_scope(profiler->iso);
   HandleScope handle_scope(profiler->iso);
 
-  Local<String> title_str =
-      String::NewFromUtf8(profiler->iso, title, NewStringType::kNormal)
-          .ToLocalChecked();
+  Local<String> title_str = String::NewFromUtf8(profiler->iso, title,
+                                                NewStringType::kNormal,
+                                                title_len)
+                                .ToLocalChecked();
   profiler->ptr->StartProfiling(title_str);
 }
 
@@ -162,7 +191,9 @@ CPUProfileNode* NewCPUProfileNode(const CpuProfileNode* ptr_) {
   return root;
 }
 
-CPUProfile* CPUProfilerStopProfiling(CPUProfiler* profiler, const char* title) {
+CPUProfile* CPUProfilerStopProfiling(CPUProfiler* profiler,
+                                     const char* title,
+                                     int title_len) {
   if (profiler->iso == nullptr) {
     return nullptr;
   }
@@ -171,9 +202,10 @@ CPUProfile* CPUProfilerStopProfiling(CPUProfiler* profiler, const char* title) {
   Isolate::Scope isolate_scope(profiler->iso);
   HandleScope handle_scope(profiler->iso);
 
-  Local<String> title_str =
-      String::NewFromUtf8(profiler->iso, title, NewStringType::kNormal)
-          .ToLocalChecked();
+  Local<String> title_str = String::NewFromUtf8(profiler->iso, title,
+                                                NewStringType::kNormal,
+                                                title_len)
+                                .ToLocalChecked();
 
   CPUProfile* profile = new CPUProfile;
   profile->ptr = profiler->ptr->StopProfiling(title_str);
@@ -219,14 +251,25 @@ void TemplateFreeWrapper(TemplatePtr tmpl) {
   delete tmpl;
 }
 
+void TemplateReleaseMany(IsolatePtr iso, TemplatePtr* ptrs, int len) {
+  Locker locker(iso);
+
+  for (int i = 0; i < len; ++i) {
+    ptrs[i]->ptr.Reset();
+    delete ptrs[i];
+  }
+}
+
 void TemplateSetValue(TemplatePtr ptr,
                       const char* name,
+                      int name_len,
                       ValuePtr val,
                       int attributes) {
   LOCAL_TEMPLATE(ptr);
 
   Local<String> prop_name =
-      String::NewFromUtf8(iso, name, NewStringType::kNormal).ToLocalChecked();
+      String::NewFromUtf8(iso, name, NewStringType::kInternalized, name_len)
+          .ToLocalChecked();
   tmpl->Set(prop_name, val->ptr.Get(iso), (PropertyAttribute)attributes);
 }
 
@@ -247,12 +290,14 @@ int TemplateSetAnyValue(TemplatePtr ptr,
 
 void TemplateSetTemplate(TemplatePtr ptr,
                          const char* name,
+                         int name_len,
                          TemplatePtr obj,
                          int attributes) {
   LOCAL_TEMPLATE(ptr);
 
   Local<String> prop_name =
-      String::NewFromUtf8(iso, name, NewStringType::kNormal).ToLocalChecked();
+      String::NewFromUtf8(iso, name, NewStringType::kInternalized, name_len)
+          .ToLocalChecked();
   tmpl->Set(prop_name, obj->ptr.Get(iso), (PropertyAttribute)attributes);
 }
 
@@ -273,13 +318,15 @@ int TemplateSetAnyTemplate(TemplatePtr ptr,
 
 /********** Context **********/
 
-RtnValue JSONParse(ContextPtr ctx, const char* str) {
+RtnValue JSONParse(ContextPtr ctx, const char* str, int len) {
   LOCAL_CONTEXT(ctx);
   RtnValue rtn = {};
 
   Local<String> v8Str;
-  if (!String::NewFromUtf8(iso, str, NewStringType::kNormal).ToLocal(&v8Str)) {
+  if (!String::NewFromUtf8(iso, str, NewStringType::kNormal, len)
+           .ToLocal(&v8Str)) {
     rtn.error = ExceptionError(try_catch, iso, local_ctx);
+    return rtn;
   }
 
   Local<Value> result;
@@ -287,13 +334,7 @@ RtnValue JSONParse(ContextPtr ctx, const char* str) {
     rtn.error = ExceptionError(try_catch, iso, local_ctx);
     return rtn;
   }
-  m_value* val = new m_value;
-  val->id = 0;
-  val->iso = iso;
-  val->ctx = ctx;
-  val->ptr = Global<Value>(iso, result);
-
-  rtn.value = tracked_value(ctx, val);
+  rtn.value = tracked_value(ctx, result);
   return rtn;
 }
 
@@ -332,6 +373,19 @@ const char* JSONStringify(ContextPtr ctx, ValuePtr val) {
   return CopyString(json);
 }
 
+RtnValue JSONStringifyValue(ContextPtr ctx, ValuePtr val) {
+  LOCAL_CONTEXT(ctx);
+  RtnValue rtn = {};
+
+  Local<String> str;
+  if (!JSON::Stringify(local_ctx, val->ptr.Get(iso)).ToLocal(&str)) {
+    rtn.error = ExceptionError(try_catch, iso, local_ctx);
+    return rtn;
+  }
+  rtn.value = tracked_value(ctx, str);
+  return rtn;
+}
+
 /********** Exception **********/
 
 const char* ExceptionGetMessageString(ValuePtr ptr) {
@@ -353,12 +407,7 @@ RtnValue NewPromiseResolver(ContextPtr ctx) {
     rtn.error = ExceptionError(try_catch, iso, local_ctx);
     return rtn;
   }
-  m_value* val = new m_value;
-  val->id = 0;
-  val->iso = iso;
-  val->ctx = ctx;
-  val->ptr = Global<Value>(iso, resolver);
-  rtn.value = tracked_value(ctx, val);
+  rtn.value = tracked_value(ctx, resolver);
   return rtn;
 }
 
@@ -366,12 +415,7 @@ ValuePtr PromiseResolverGetPromise(ValuePtr ptr) {
   LOCAL_VALUE(ptr);
   Local<Promise::Resolver> resolver = value.As<Promise::Resolver>();
   Local<Promise> promise = resolver->GetPromise();
-  m_value* promise_val = new m_value;
-  promise_val->id = 0;
-  promise_val->iso = iso;
-  promise_val->ctx = ctx;
-  promise_val->ptr = Global<Value>(iso, promise);
-  return tracked_value(ctx, promise_val);
+  return tracked_value(ctx, promise);
 }
 
 int PromiseResolverResolve(ValuePtr ptr, ValuePtr resolve_val) {
@@ -396,7 +440,8 @@ RtnValue PromiseThen(ValuePtr ptr, int callback_ref) {
   LOCAL_VALUE(ptr)
   RtnValue rtn = {};
   Local<Promise> promise = value.As<Promise>();
-  Local<Integer> cbData = Integer::New(iso, callback_ref);
+  Local<Value> cbData =
+      NewCallbackData(iso, callback_ref, CALLBACK_TABLE_FUNCTION);
   Local<Function> func;
   if (!Function::New(local_ctx, FunctionTemplateCallback, cbData)
            .ToLocal(&func)) {
@@ -408,12 +453,7 @@ RtnValue PromiseThen(ValuePtr ptr, int callback_ref) {
     rtn.error = ExceptionError(try_catch, iso, local_ctx);
     return rtn;
   }
-  m_value* result_val = new m_value;
-  result_val->id = 0;
-  result_val->iso = iso;
-  result_val->ctx = ctx;
-  result_val->ptr = Global<Value>(iso, result);
-  rtn.value = tracked_value(ctx, result_val);
+  rtn.value = tracked_value(ctx, result);
   return rtn;
 }
 
@@ -421,14 +461,16 @@ RtnValue PromiseThen2(ValuePtr ptr, int on_fulfilled_ref, int on_rejected_ref) {
   LOCAL_VALUE(ptr)
   RtnValue rtn = {};
   Local<Promise> promise = value.As<Promise>();
-  Local<Integer> onFulfilledData = Integer::New(iso, on_fulfilled_ref);
+  Local<Value> onFulfilledData =
+      NewCallbackData(iso, on_fulfilled_ref, CALLBACK_TABLE_FUNCTION);
   Local<Function> onFulfilledFunc;
   if (!Function::New(local_ctx, FunctionTemplateCallback, onFulfilledData)
            .ToLocal(&onFulfilledFunc)) {
     rtn.error = ExceptionError(try_catch, iso, local_ctx);
     return rtn;
   }
-  Local<Integer> onRejectedData = Integer::New(iso, on_rejected_ref);
+  Local<Value> onRejectedData =
+      NewCallbackData(iso, on_rejected_ref, CALLBACK_TABLE_FUNCTION);
   Local<Function> onRejectedFunc;
   if (!Function::New(local_ctx, FunctionTemplateCallback, onRejectedData)
            .ToLocal(&onRejectedFunc)) {
@@ -441,12 +483,7 @@ RtnValue PromiseThen2(ValuePtr ptr, int on_fulfilled_ref, int on_rejected_ref) {
     rtn.error = ExceptionError(try_catch, iso, local_ctx);
     return rtn;
   }
-  m_value* result_val = new m_value;
-  result_val->id = 0;
-  result_val->iso = iso;
-  result_val->ctx = ctx;
-  result_val->ptr = Global<Value>(iso, result);
-  rtn.value = tracked_value(ctx, result_val);
+  rtn.value = tracked_value(ctx, result);
   return rtn;
 }
 
@@ -454,7 +491,8 @@ RtnValue PromiseCatch(ValuePtr ptr, int callback_ref) {
   LOCAL_VALUE(ptr)
   RtnValue rtn = {};
   Local<Promise> promise = value.As<Promise>();
-  Local<Integer> cbData = Integer::New(iso, callback_ref);
+  Local<Value> cbData =
+      NewCallbackData(iso, callback_ref, CALLBACK_TABLE_FUNCTION);
   Local<Function> func;
   if (!Function::New(local_ctx, FunctionTemplateCallback, cbData)
            .ToLocal(&func)) {
@@ -466,12 +504,7 @@ RtnValue PromiseCatch(ValuePtr ptr, int callback_ref) {
     rtn.error = ExceptionError(try_catch, iso, local_ctx);
     return rtn;
   }
-  m_value* result_val = new m_value;
-  result_val->id = 0;
-  result_val->iso = iso;
-  result_val->ctx = ctx;
-  result_val->ptr = Global<Value>(iso, result);
-  rtn.value = tracked_value(ctx, result_val);
+  rtn.value = tracked_value(ctx, result);
   return rtn;
 }
 
@@ -479,12 +512,7 @@ ValuePtr PromiseResult(ValuePtr ptr) {
   LOCAL_VALUE(ptr)
   Local<Promise> promise = value.As<Promise>();
   Local<Value> result = promise->Result();
-  m_value* result_val = new m_value;
-  result_val->id = 0;
-  result_val->iso = iso;
-  result_val->ctx = ctx;
-  result_val->ptr = Global<Value>(iso, result);
-  return tracked_value(ctx, result_val);
+  return tracked_value(ctx, result);
 }
 
 /********** Function **********/
@@ -513,12 +541,7 @@ RtnValue FunctionCall(ValuePtr ptr, ValuePtr recv, int argc, ValuePtr args[]) {
     rtn.error = ExceptionError(try_catch, iso, local_ctx);
     return rtn;
   }
-  m_value* rtnval = new m_value;
-  rtnval->id = 0;
-  rtnval->iso = iso;
-  rtnval->ctx = ctx;
-  rtnval->ptr = Global<Value>(iso, result);
-  rtn.value = tracked_value(ctx, rtnval);
+  rtn.value = tracked_value(ctx, result);
   return rtn;
 }
 
@@ -533,12 +556,7 @@ RtnValue FunctionNewInstance(ValuePtr ptr, int argc, ValuePtr args[]) {
     rtn.error = ExceptionError(try_catch, iso, local_ctx);
     return rtn;
   }
-  m_value* rtnval = new m_value;
-  rtnval->id = 0;
-  rtnval->iso = iso;
-  rtnval->ctx = ctx;
-  rtnval->ptr = Global<Value>(iso, result);
-  rtn.value = tracked_value(ctx, rtnval);
+  rtn.value = tracked_value(ctx, result);
   return rtn;
 }
 
@@ -546,12 +564,7 @@ ValuePtr FunctionSourceMapUrl(ValuePtr ptr) {
   LOCAL_VALUE(ptr)
   Local<Function> fn = Local<Function>::Cast(value);
   Local<Value> result = fn->GetScriptOrigin().SourceMapUrl();
-  m_value* rtnval = new m_value;
-  rtnval->id = 0;
-  rtnval->iso = iso;
-  rtnval->ctx = ctx;
-  rtnval->ptr = Global<Value>(iso, result);
-  return tracked_value(ctx, rtnval);
+  return tracked_value(ctx, result);
 }
 
 /********** v8::V8 **********/
@@ -11,6 +11,8 @@ package v8go
 // #include <stdlib.h>
 import "C"
 import (
+	"encoding/binary"
+	"hash/fnv"
 	"strings"
 	"sync"
 	"unsafe"
@@ -26,9 +28,30 @@ func Version() string {
 // Flags can be reverted using the `--no` prefix equivalent, for example: `--use_strict` vs `--nouse_strict`.
 // Flags will affect all Isolates created, even after creation.
 func SetFlags(flags ...string) {
-	cflags := C.CString(strings.Join(flags, " "))
+	joined := strings.Join(flags, " ")
+	cflags := C.CString(joined)
 	C.SetFlags(cflags)
 	C.free(unsafe.Pointer(cflags))
+
+	flagsMu.Lock()
+	defer flagsMu.Unlock()
+	h := fnv.New64a()
+	binary.Write(h, binary.LittleEndian, flagsHash)
+	h.Write([]byte(joined))
+	flagsHash = h.Sum64()
+}
+
+var (
+	flagsMu sync.Mutex
+	// flagsHash identifies the sequence of flags passed to SetFlags, so code
+	// caches can tell whether they were created with the same flags.
+	flagsHash uint64
+)
+
+func currentFlagsHash() uint64 {
+	flagsMu.Lock()
+	defer flagsMu.Unlock()
+	return flagsHash
 }
 
 func initializeIfNecessary() {
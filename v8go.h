@@ -81,14 +81,19 @@ extern void Init();
 
 extern CPUProfiler* NewCPUProfiler(IsolatePtr iso_ptr);
 extern void CPUProfilerDispose(CPUProfiler* ptr);
-extern void CPUProfilerStartProfiling(CPUProfiler* ptr, const char* title);
+extern void CPUProfilerStartProfiling(CPUProfiler* ptr,
+                                      const char* title,
+                                      int title_len);
 extern CPUProfile* CPUProfilerStopProfiling(CPUProfiler* ptr,
-                                            const char* title);
+                                            const char* title,
+                                            int title_len);
 extern void CPUProfileDelete(CPUProfile* ptr);
 
 extern void TemplateFreeWrapper(TemplatePtr ptr);
+extern void TemplateReleaseMany(IsolatePtr iso, TemplatePtr* ptrs, int len);
 extern void TemplateSetValue(TemplatePtr ptr,
                              const char* name,
+                             int name_len,
                              ValuePtr val_ptr,
                              int attributes);
 extern int TemplateSetAnyValue(TemplatePtr ptr,
@@ -97,6 +102,7 @@ extern int TemplateSetAnyValue(TemplatePtr ptr,
                                int attributes);
 extern void TemplateSetTemplate(TemplatePtr ptr,
                                 const char* name,
+                                int name_len,
                                 TemplatePtr obj_ptr,
                                 int attributes);
 extern int TemplateSetAnyTemplate(TemplatePtr ptr,
@@ -2,6 +2,8 @@
 
 #include <stdlib.h>
 
+#include <algorithm>
+
 #include "context.h"
 #include "deps/include/v8-context.h"
 #include "deps/include/v8-exception.h"
@@ -31,6 +33,78 @@ RtnString ExceptionToRtnString(TryCatch& try_catch,
   return res;
 }
 
+uint32_t value_kinds(Local<Value> value) {
+  // Most kinds are mutually exclusive, so this is a chain of tests rather than
+  // one call per bit.
+  if (value->IsObject()) {
+    uint32_t kinds = VALUE_KIND_OBJECT;
+    if (value->IsFunction()) {
+      kinds |= VALUE_KIND_FUNCTION;
+    }
+    if (value->IsProxy()) {
+      return kinds | VALUE_KIND_PROXY;
+    }
+    if (value->IsArray()) {
+      kinds |= VALUE_KIND_ARRAY;
+    } else if (value->IsPromise()) {
+      kinds |= VALUE_KIND_PROMISE;
+    } else if (value->IsNativeError()) {
+      kinds |= VALUE_KIND_NATIVE_ERROR;
+    } else if (value->IsDate()) {
+      kinds |= VALUE_KIND_DATE;
+    } else if (value->IsRegExp()) {
+      kinds |= VALUE_KIND_REGEXP;
+    } else if (value->IsMap()) {
+      kinds |= VALUE_KIND_MAP;
+    } else if (value->IsSet()) {
+      kinds |= VALUE_KIND_SET;
+    } else if (value->IsArrayBuffer()) {
+      kinds |= VALUE_KIND_ARRAY_BUFFER;
+    } else if (value->IsSharedArrayBuffer()) {
+      kinds |= VALUE_KIND_SHARED_ARRAY_BUFFER;
+    } else if (value->IsArrayBufferView()) {
+      kinds |= VALUE_KIND_ARRAY_BUFFER_VIEW;
+      if (value->IsTypedArray()) {
+        kinds |= VALUE_KIND_TYPED_ARRAY;
+      }
+    }
+    return kinds;
+  }
+
+  if (value->IsString()) {
+    return VALUE_KIND_STRING;
+  }
+  if (value->IsNumber()) {
+    uint32_t kinds = VALUE_KIND_NUMBER;
+    if (value->IsInt32()) {
+      kinds |= VALUE_KIND_INT32;
+    }
+    if (value->IsUint32()) {
+      kinds |= VALUE_KIND_UINT32;
+    }
+    return kinds;
+  }
+  if (value->IsUndefined()) {
+    return VALUE_KIND_UNDEFINED;
+  }
+  if (value->IsNull()) {
+    return VALUE_KIND_NULL;
+  }
+  if (value->IsTrue()) {
+    return VALUE_KIND_TRUE;
+  }
+  if (value->IsFalse()) {
+    return VALUE_KIND_FALSE;
+  }
+  if (value->IsSymbol()) {
+    return VALUE_KIND_SYMBOL;
+  }
+  if (value->IsBigInt()) {
+    return VALUE_KIND_BIGINT;
+  }
+  return 0;
+}
+
 void RtnStringRelease(RtnString rtnString) {
   free(rtnString.data);
   ErrorRelease(rtnString.error);
@@ -41,29 +115,38 @@ void ValueRelease(ValuePtr ptr) {
     return;
   }
 
-  ptr->ctx->vals.erase(ptr->id);
-  ptr->ptr.Reset();
-  delete ptr;
+  release_value(ptr);
+}
+
+void ValueReleaseMany(ValuePtr* ptrs, int len) {
+  if (len == 0) {
+    return;
+  }
+  Locker locker(ptrs[0]->iso);
+
+  for (int i = 0; i < len; ++i) {
+    release_value(ptrs[i]);
+  }
+}
+
+// ValueEscape hands the value to the scope enclosing the one at depth. It
+// never moves a value to an inner scope, so escaping twice, or from an outer
+// scope, has no further effect.
+void ValueEscape(ValuePtr ptr, int depth) {
+  Locker locker(ptr->iso);
+  if (ptr->scope >= depth) {
+    ptr->scope = depth - 1;
+  }
 }
 
 ValuePtr NewValueInteger(IsolatePtr iso, int32_t v) {
   ISOLATE_SCOPE_INTERNAL_CONTEXT(iso);
-  m_value* val = new m_value;
-  val->id = 0;
-  val->iso = iso;
-  val->ctx = ctx;
-  val->ptr = Global<Value>(iso, Integer::New(iso, v));
-  return tracked_value(ctx, val);
+  return tracked_value(ctx, Integer::New(iso, v));
 }
 
 ValuePtr NewValueIntegerFromUnsigned(IsolatePtr iso, uint32_t v) {
   ISOLATE_SCOPE_INTERNAL_CONTEXT(iso);
-  m_value* val = new m_value;
-  val->id = 0;
-  val->iso = iso;
-  val->ctx = ctx;
-  val->ptr = Global<Value>(iso, Integer::NewFromUnsigned(iso, v));
-  return tracked_value(ctx, val);
+  return tracked_value(ctx, Integer::NewFromUnsigned(iso, v));
 }
 
 RtnValue NewValueString(IsolatePtr iso, const char* v, int v_length) {
@@ -76,73 +159,38 @@ RtnValue NewValueString(IsolatePtr iso, const char* v, int v_length) {
     rtn.error = ExceptionError(try_catch, iso, ctx->ptr.Get(iso));
     return rtn;
   }
-  m_value* val = new m_value;
-  val->id = 0;
-  val->iso = iso;
-  val->ctx = ctx;
-  val->ptr = Global<Value>(iso, str);
-  rtn.value = tracked_value(ctx, val);
+  rtn.value = tracked_value(ctx, str);
   return rtn;
 }
 
 ValuePtr NewValueNull(IsolatePtr iso) {
   ISOLATE_SCOPE_INTERNAL_CONTEXT(iso);
-  m_value* val = new m_value;
-  val->id = 0;
-  val->iso = iso;
-  val->ctx = ctx;
-  val->ptr = Global<Value>(iso, Null(iso));
-  return tracked_value(ctx, val);
+  return tracked_value(ctx, Null(iso));
 }
 
 ValuePtr NewValueUndefined(IsolatePtr iso) {
   ISOLATE_SCOPE_INTERNAL_CONTEXT(iso);
-  m_value* val = new m_value;
-  val->id = 0;
-  val->iso = iso;
-  val->ctx = ctx;
-  val->ptr = Global<Value>(iso, Undefined(iso));
-  return tracked_value(ctx, val);
+  return tracked_value(ctx, Undefined(iso));
 }
 
 ValuePtr NewValueBoolean(IsolatePtr iso, int v) {
   ISOLATE_SCOPE_INTERNAL_CONTEXT(iso);
-  m_value* val = new m_value;
-  val->id = 0;
-  val->iso = iso;
-  val->ctx = ctx;
-  val->ptr = Global<Value>(iso, Boolean::New(iso, v));
-  return tracked_value(ctx, val);
+  return tracked_value(ctx, Boolean::New(iso, v));
 }
 
 ValuePtr NewValueNumber(IsolatePtr iso, double v) {
   ISOLATE_SCOPE_INTERNAL_CONTEXT(iso);
-  m_value* val = new m_value;
-  val->id = 0;
-  val->iso = iso;
-  val->ctx = ctx;
-  val->ptr = Global<Value>(iso, Number::New(iso, v));
-  return tracked_value(ctx, val);
+  return tracked_value(ctx, Number::New(iso, v));
 }
 
 ValuePtr NewValueBigInt(IsolatePtr iso, int64_t v) {
   ISOLATE_SCOPE_INTERNAL_CONTEXT(iso);
-  m_value* val = new m_value;
-  val->id = 0;
-  val->iso = iso;
-  val->ctx = ctx;
-  val->ptr = Global<Value>(iso, BigInt::New(iso, v));
-  return tracked_value(ctx, val);
+  return tracked_value(ctx, BigInt::New(iso, v));
 }
 
 ValuePtr NewValueBigIntFromUnsigned(IsolatePtr iso, uint64_t v) {
   ISOLATE_SCOPE_INTERNAL_CONTEXT(iso);
-  m_value* val = new m_value;
-  val->id = 0;
-  val->iso = iso;
-  val->ctx = ctx;
-  val->ptr = Global<Value>(iso, BigInt::NewFromUnsigned(iso, v));
-  return tracked_value(ctx, val);
+  return tracked_value(ctx, BigInt::NewFromUnsigned(iso, v));
 }
 
 RtnValue NewValueBigIntFromWords(IsolatePtr iso,
@@ -160,23 +208,21 @@ RtnValue NewValueBigIntFromWords(IsolatePtr iso,
     rtn.error = ExceptionError(try_catch, iso, local_ctx);
     return rtn;
   }
-  m_value* val = new m_value;
-  val->id = 0;
-  val->iso = iso;
-  val->ctx = ctx;
-  val->ptr = Global<Value>(iso, bigint);
-  rtn.value = tracked_value(ctx, val);
+  rtn.value = tracked_value(ctx, bigint);
   return rtn;
 }
 
 ValuePtr NewValueError(IsolatePtr iso,
                        ErrorTypeIndex idx,
-                       const char* message) {
+                       const char* message,
+                       int message_len) {
   ISOLATE_SCOPE_INTERNAL_CONTEXT(iso);
   Local<Context> local_ctx = ctx->ptr.Get(iso);
   Context::Scope context_scope(local_ctx);
 
-  Local<String> local_msg = String::NewFromUtf8(iso, message).ToLocalChecked();
+  Local<String> local_msg =
+      String::NewFromUtf8(iso, message, NewStringType::kNormal, message_len)
+          .ToLocalChecked();
   Local<Value> v;
   switch (idx) {
     case ERROR_RANGE:
@@ -206,12 +252,7 @@ ValuePtr NewValueError(IsolatePtr iso,
     default:
       return nullptr;
   }
-  m_value* val = new m_value;
-  val->id = 0;
-  val->iso = iso;
-  val->ctx = ctx;
-  val->ptr = Global<Value>(iso, v);
-  return tracked_value(ctx, val);
+  return tracked_value(ctx, v);
 }
 
 const uint32_t* ValueToArrayIndex(ValuePtr ptr) {
@@ -270,6 +311,119 @@ RtnString ValueToString(ValuePtr ptr) {
   return rtn;
 }
 
+// valueString converts the value like `String(value)` in JS, or returns an
+// empty string if the conversion throws, like ValueToString.
+static Local<String> valueString(Isolate* iso,
+                                 Local<Context> local_ctx,
+                                 Local<Value> value) {
+  if (value->IsString()) {
+    return value.As<String>();
+  }
+  Local<String> str;
+  if (!value->ToString(local_ctx).ToLocal(&str)) {
+    return String::Empty(iso);
+  }
+  return str;
+}
+
+int ValueWriteUtf8(ValuePtr ptr, char* buf, int cap) {
+  LOCAL_VALUE(ptr);
+  Local<String> str = valueString(iso, local_ctx, value);
+  int length = static_cast<int>(str->Utf8LengthV2(iso));
+  if (length <= cap) {
+    str->WriteUtf8V2(iso, buf, length);
+  }
+  return length;
+}
+
+int ValueWriteUtf16(ValuePtr ptr, uint16_t* buf, int cap) {
+  LOCAL_VALUE(ptr);
+  Local<String> str = valueString(iso, local_ctx, value);
+  int length = str->Length();
+  if (length <= cap) {
+    str->WriteV2(iso, 0, length, buf);
+  }
+  return length;
+}
+
+int ValueWriteLatin1(ValuePtr ptr, uint8_t* buf, int cap) {
+  LOCAL_VALUE(ptr);
+  Local<String> str = valueString(iso, local_ctx, value);
+  if (!str->IsOneByte() && !str->ContainsOnlyOneByte()) {
+    return -1;
+  }
+  int length = str->Length();
+  if (length <= cap) {
+    str->WriteOneByteV2(iso, 0, length, buf);
+  }
+  return length;
+}
+
+// The UTF-16 code units ValueWriteUtf8Chunk reads from V8 at a time.
+static const int kChunkUnits = 4096;
+
+RtnStringChunk ValueWriteUtf8Chunk(ValuePtr ptr,
+                                   int offset,
+                                   char* buf,
+                                   int cap) {
+  LOCAL_VALUE(ptr);
+  RtnStringChunk rtn = {};
+  Local<String> str = valueString(iso, local_ctx, value);
+  int length = str->Length();
+
+  uint16_t units[kChunkUnits];
+  char* out = buf;
+  while (offset < length) {
+    // A code unit takes at most three bytes, and a surrogate pair four.
+    int space = static_cast<int>(buf + cap - out);
+    int n = std::min({kChunkUnits, length - offset, space / 3});
+    if (n == 0) {
+      break;
+    }
+    str->WriteV2(iso, offset, n, units);
+    if (offset + n < length && units[n - 1] >= 0xD800 &&
+        units[n - 1] <= 0xDBFF) {
+      if (n > 1) {
+        // Leave a high surrogate for the next window if its pair is split.
+        --n;
+      } else if (space >= 6) {
+        // The pair, or two lone surrogates, take at most six bytes.
+        n = 2;
+        str->WriteV2(iso, offset, n, units);
+      } else {
+        break;
+      }
+    }
+
+    for (int i = 0; i < n; ++i) {
+      uint32_t c = units[i];
+      if (c < 0x80) {
+        *out++ = static_cast<char>(c);
+      } else if (c < 0x800) {
+        *out++ = static_cast<char>(0xC0 | (c >> 6));
+        *out++ = static_cast<char>(0x80 | (c & 0x3F));
+      } else if (c >= 0xD800 && c <= 0xDBFF && i + 1 < n &&
+                 units[i + 1] >= 0xDC00 && units[i + 1] <= 0xDFFF) {
+        c = 0x10000 + ((c - 0xD800) << 10) + (units[++i] - 0xDC00);
+        *out++ = static_cast<char>(0xF0 | (c >> 18));
+        *out++ = static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+        *out++ = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (c & 0x3F));
+      } else {
+        // Lone surrogates are encoded like WriteUtf8V2 does by default.
+        *out++ = static_cast<char>(0xE0 | (c >> 12));
+        *out++ = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (c & 0x3F));
+      }
+    }
+    offset += n;
+  }
+
+  rtn.length = static_cast<int>(out - buf);
+  rtn.next = offset < length ? offset : -1;
+  return rtn;
+}
+
 uint32_t ValueToUint32(ValuePtr ptr) {
   LOCAL_VALUE(ptr);
   return value->Uint32Value(local_ctx).ToChecked();
@@ -298,12 +452,7 @@ RtnValue ValueToObject(ValuePtr ptr) {
     rtn.error = ExceptionError(try_catch, iso, local_ctx);
     return rtn;
   }
-  m_value* new_val = new m_value;
-  new_val->id = 0;
-  new_val->iso = iso;
-  new_val->ctx = ctx;
-  new_val->ptr = Global<Value>(iso, obj);
-  rtn.value = tracked_value(ctx, new_val);
+  rtn.value = tracked_value(ctx, obj);
   return rtn;
 }
 
@@ -316,91 +465,11 @@ int ValueSameValue(ValuePtr val1, ValuePtr val2) {
   return value1->SameValue(value2);
 }
 
-int ValueIsUndefined(ValuePtr ptr) {
-  LOCAL_VALUE(ptr);
-  return value->IsUndefined();
-}
-
-int ValueIsNull(ValuePtr ptr) {
-  LOCAL_VALUE(ptr);
-  return value->IsNull();
-}
-
-int ValueIsNullOrUndefined(ValuePtr ptr) {
-  LOCAL_VALUE(ptr);
-  return value->IsNullOrUndefined();
-}
-
-int ValueIsTrue(ValuePtr ptr) {
-  LOCAL_VALUE(ptr);
-  return value->IsTrue();
-}
-
-int ValueIsFalse(ValuePtr ptr) {
-  LOCAL_VALUE(ptr);
-  return value->IsFalse();
-}
-
-int ValueIsName(ValuePtr ptr) {
-  LOCAL_VALUE(ptr);
-  return value->IsName();
-}
-
-int ValueIsString(ValuePtr ptr) {
-  LOCAL_VALUE(ptr);
-  return value->IsString();
-}
-
-int ValueIsSymbol(ValuePtr ptr) {
-  LOCAL_VALUE(ptr);
-  return value->IsSymbol();
-}
-
-int ValueIsFunction(ValuePtr ptr) {
-  LOCAL_VALUE(ptr);
-  return value->IsFunction();
-}
-
-int ValueIsObject(ValuePtr ptr) {
-  LOCAL_VALUE(ptr);
-  return value->IsObject();
-}
-
-int ValueIsBigInt(ValuePtr ptr) {
-  LOCAL_VALUE(ptr);
-  return value->IsBigInt();
-}
-
-int ValueIsBoolean(ValuePtr ptr) {
-  LOCAL_VALUE(ptr);
-  return value->IsBoolean();
-}
-
-int ValueIsNumber(ValuePtr ptr) {
-  LOCAL_VALUE(ptr);
-  return value->IsNumber();
-}
-
 int ValueIsExternal(ValuePtr ptr) {
   LOCAL_VALUE(ptr);
   return value->IsExternal();
 }
 
-int ValueIsInt32(ValuePtr ptr) {
-  LOCAL_VALUE(ptr);
-  return value->IsInt32();
-}
-
-int ValueIsUint32(ValuePtr ptr) {
-  LOCAL_VALUE(ptr);
-  return value->IsUint32();
-}
-
-int ValueIsDate(ValuePtr ptr) {
-  LOCAL_VALUE(ptr);
-  return value->IsDate();
-}
-
 int ValueIsArgumentsObject(ValuePtr ptr) {
   LOCAL_VALUE(ptr);
   return value->IsArgumentsObject();
@@ -426,16 +495,6 @@ int ValueIsSymbolObject(ValuePtr ptr) {
   return value->IsSymbolObject();
 }
 
-int ValueIsNativeError(ValuePtr ptr) {
-  LOCAL_VALUE(ptr);
-  return value->IsNativeError();
-}
-
-int ValueIsRegExp(ValuePtr ptr) {
-  LOCAL_VALUE(ptr);
-  return value->IsRegExp();
-}
-
 int ValueIsAsyncFunction(ValuePtr ptr) {
   LOCAL_VALUE(ptr);
   return value->IsAsyncFunction();
@@ -451,21 +510,6 @@ int ValueIsGeneratorObject(ValuePtr ptr) {
   return value->IsGeneratorObject();
 }
 
-int ValueIsPromise(ValuePtr ptr) {
-  LOCAL_VALUE(ptr);
-  return value->IsPromise();
-}
-
-int ValueIsMap(ValuePtr ptr) {
-  LOCAL_VALUE(ptr);
-  return value->IsMap();
-}
-
-int ValueIsSet(ValuePtr ptr) {
-  LOCAL_VALUE(ptr);
-  return value->IsSet();
-}
-
 int ValueIsMapIterator(ValuePtr ptr) {
   LOCAL_VALUE(ptr);
   return value->IsMapIterator();
@@ -486,26 +530,6 @@ int ValueIsWeakSet(ValuePtr ptr) {
   return value->IsWeakSet();
 }
 
-int ValueIsArray(ValuePtr ptr) {
-  LOCAL_VALUE(ptr);
-  return value->IsArray();
-}
-
-int ValueIsArrayBuffer(ValuePtr ptr) {
-  LOCAL_VALUE(ptr);
-  return value->IsArrayBuffer();
-}
-
-int ValueIsArrayBufferView(ValuePtr ptr) {
-  LOCAL_VALUE(ptr);
-  return value->IsArrayBufferView();
-}
-
-int ValueIsTypedArray(ValuePtr ptr) {
-  LOCAL_VALUE(ptr);
-  return value->IsTypedArray();
-}
-
 int ValueIsUint8Array(ValuePtr ptr) {
   LOCAL_VALUE(ptr);
   return value->IsUint8Array();
@@ -566,16 +590,6 @@ int ValueIsDataView(ValuePtr ptr) {
   return value->IsDataView();
 }
 
-int ValueIsSharedArrayBuffer(ValuePtr ptr) {
-  LOCAL_VALUE(ptr);
-  return value->IsSharedArrayBuffer();
-}
-
-int ValueIsProxy(ValuePtr ptr) {
-  LOCAL_VALUE(ptr);
-  return value->IsProxy();
-}
-
 int ValueIsWasmModuleObject(ValuePtr ptr) {
   LOCAL_VALUE(ptr);
   return value->IsWasmModuleObject();
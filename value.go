@@ -11,7 +11,11 @@ import (
 	"errors"
 	"fmt"
 	"io"
+	"math"
 	"math/big"
+	"runtime"
+	"sync"
+	"unicode/utf16"
 	"unsafe"
 )
 
@@ -31,6 +35,16 @@ func (v *Value) value() *Value {
 	return v
 }
 
+// newValue wraps a value owned by ctx, which may be nil for values owned by
+// the isolate.
+func newValue(ptr C.ValuePtr, ctx *Context) *Value {
+	v := &Value{ptr, ctx}
+	if ctx != nil && ctx.iso.autoRelease {
+		ctx.setReleaseFinalizer(v)
+	}
+	return v
+}
+
 func newValueNull(iso *Isolate) *Value {
 	return &Value{
 		ptr: C.NewValueNull(iso.ptr),
@@ -71,9 +85,8 @@ func NewValue(iso *Isolate, val interface{}) (*Value, error) {
 
 	switch v := val.(type) {
 	case string:
-		cstr := C.CString(v)
-		defer C.free(unsafe.Pointer(cstr))
-		rtn := C.NewValueString(iso.ptr, cstr, C.int(len(v)))
+		cstr, n := cStringN(v)
+		rtn := C.NewValueString(iso.ptr, cstr, n)
 		return valueResult(nil, rtn)
 	case int32:
 		rtnVal = &Value{
@@ -159,6 +172,7 @@ func (v *Value) Format(s fmt.State, verb rune) {
 // ArrayIndex attempts to converts a string to an array index. Returns ok false if conversion fails.
 func (v *Value) ArrayIndex() (idx uint32, ok bool) {
 	arrayIdx := C.ValueToArrayIndex(v.ptr)
+	runtime.KeepAlive(v)
 	defer C.free(unsafe.Pointer(arrayIdx))
 	if arrayIdx == nil {
 		return 0, false
@@ -172,6 +186,7 @@ func (v *Value) BigInt() *big.Int {
 		return nil
 	}
 	bint := C.ValueToBigInt(v.ptr)
+	runtime.KeepAlive(v)
 	defer C.free(unsafe.Pointer(bint.word_array))
 	if bint.word_array == nil {
 		return nil
@@ -193,12 +208,15 @@ func (v *Value) BigInt() *big.Int {
 
 // Boolean perform the equivalent of `Boolean(value)` in JS. This can never fail.
 func (v *Value) Boolean() bool {
-	return C.ValueToBoolean(v.ptr) != 0
+	rtn := C.ValueToBoolean(v.ptr) != 0
+	runtime.KeepAlive(v)
+	return rtn
 }
 
 // DetailString provide a string representation of this value usable for debugging.
 func (v *Value) DetailString() string {
 	rtn := C.ValueToDetailString(v.ptr)
+	runtime.KeepAlive(v)
 	if rtn.data == nil {
 		err := newJSError(rtn.error)
 		panic(err) // TODO: Return a fallback value
@@ -210,25 +228,32 @@ func (v *Value) DetailString() string {
 // Int32 perform the equivalent of `Number(value)` in JS and convert the result to a
 // signed 32-bit integer by performing the steps in https://tc39.es/ecma262/#sec-toint32.
 func (v *Value) Int32() int32 {
-	return int32(C.ValueToInt32(v.ptr))
+	rtn := int32(C.ValueToInt32(v.ptr))
+	runtime.KeepAlive(v)
+	return rtn
 }
 
 // Integer perform the equivalent of `Number(value)` in JS and convert the result to an integer.
 // Negative values are rounded up, positive values are rounded down. NaN is converted to 0.
 // Infinite values yield undefined results.
 func (v *Value) Integer() int64 {
-	return int64(C.ValueToInteger(v.ptr))
+	rtn := int64(C.ValueToInteger(v.ptr))
+	runtime.KeepAlive(v)
+	return rtn
 }
 
 // Number perform the equivalent of `Number(value)` in JS.
 func (v *Value) Number() float64 {
-	return float64(C.ValueToNumber(v.ptr))
+	rtn := float64(C.ValueToNumber(v.ptr))
+	runtime.KeepAlive(v)
+	return rtn
 }
 
 // Object perform the equivalent of Object(value) in JS.
 // To just cast this value as an Object use AsObject() instead.
 func (v *Value) Object() *Object {
 	rtn := C.ValueToObject(v.ptr)
+	runtime.KeepAlive(v)
 	obj, err := objectResult(v.ctx, rtn)
 	if err != nil {
 		panic(err) // TODO: Return error
@@ -240,99 +265,248 @@ func (v *Value) Object() *Object {
 // are returned as-is, objects will return `[object Object]` and functions will
 // print their definition.
 func (v *Value) String() string {
-	s := C.ValueToString(v.ptr)
-	defer C.RtnStringRelease(s)
-	return C.GoStringN(s.data, C.int(s.length))
+	if !v.IsString() {
+		s := C.ValueToString(v.ptr)
+		runtime.KeepAlive(v)
+		defer C.RtnStringRelease(s)
+		return C.GoStringN(s.data, C.int(s.length))
+	}
+	b := v.AppendString(make([]byte, 0, stringBufSize))
+	if cap(b) == stringBufSize {
+		// Don't keep the spare capacity alive with the string.
+		return string(b)
+	}
+	return bytesString(b)
+}
+
+// stringBufSize is how much String writes on its first attempt. Longer strings
+// are written by a second call into a buffer of the exact size.
+const stringBufSize = 64
+
+// AppendString appends `String(value)` as UTF-8 to dst. Strings are written by
+// V8 directly into dst, which is grown if needed, so reusing a buffer makes
+// reading string values free of allocations.
+func (v *Value) AppendString(dst []byte) []byte {
+	if !v.IsString() {
+		return append(dst, v.String()...)
+	}
+	n := int(C.ValueWriteUtf8(v.ptr, (*C.char)(unsafe.Pointer(spareData(dst))), spareLen(dst)))
+	runtime.KeepAlive(v)
+	if n > cap(dst)-len(dst) {
+		dst = growSlice(dst, n)
+		C.ValueWriteUtf8(v.ptr, (*C.char)(unsafe.Pointer(spareData(dst))), C.int(n))
+		runtime.KeepAlive(v)
+	}
+	return dst[:len(dst)+n]
+}
+
+// AppendUTF16 appends `String(value)` as UTF-16 code units to dst. This is
+// V8's own representation of strings that aren't Latin-1, so no transcoding
+// is needed.
+func (v *Value) AppendUTF16(dst []uint16) []uint16 {
+	if !v.IsString() {
+		return append(dst, utf16.Encode([]rune(v.String()))...)
+	}
+	n := int(C.ValueWriteUtf16(v.ptr, (*C.uint16_t)(spareData(dst)), spareLen(dst)))
+	runtime.KeepAlive(v)
+	if n > cap(dst)-len(dst) {
+		dst = growSlice(dst, n)
+		C.ValueWriteUtf16(v.ptr, (*C.uint16_t)(spareData(dst)), C.int(n))
+		runtime.KeepAlive(v)
+	}
+	return dst[:len(dst)+n]
+}
+
+// AppendLatin1 appends `String(value)` as Latin-1 (ISO-8859-1) to dst, one
+// byte per character. This is V8's own representation of most strings, so it
+// is the cheapest way to read them. It returns dst unchanged and false if the
+// string has characters beyond U+00FF.
+func (v *Value) AppendLatin1(dst []byte) ([]byte, bool) {
+	if !v.IsString() {
+		s := v.String()
+		out := dst
+		for _, r := range s {
+			if r > 0xFF {
+				return dst, false
+			}
+			out = append(out, byte(r))
+		}
+		return out, true
+	}
+	n := int(C.ValueWriteLatin1(v.ptr, (*C.uint8_t)(spareData(dst)), spareLen(dst)))
+	runtime.KeepAlive(v)
+	if n < 0 {
+		return dst, false
+	}
+	if n > cap(dst)-len(dst) {
+		dst = growSlice(dst, n)
+		C.ValueWriteLatin1(v.ptr, (*C.uint8_t)(spareData(dst)), C.int(n))
+		runtime.KeepAlive(v)
+	}
+	return dst[:len(dst)+n], true
+}
+
+// WriteStringTo writes `String(value)` as UTF-8 to w. Strings are copied out of
+// V8 in fixed-size chunks, so memory use stays constant however large the
+// string is.
+func (v *Value) WriteStringTo(w io.Writer) (int64, error) {
+	if !v.IsString() {
+		n, err := io.WriteString(w, v.String())
+		return int64(n), err
+	}
+
+	buf := stringChunkPool.Get().(*[stringChunkSize]byte)
+	defer stringChunkPool.Put(buf)
+
+	var total int64
+	for offset := 0; offset >= 0; {
+		rtn := C.ValueWriteUtf8Chunk(v.ptr, C.int(offset), (*C.char)(unsafe.Pointer(&buf[0])), stringChunkSize)
+		runtime.KeepAlive(v)
+		n, err := w.Write(buf[:rtn.length])
+		total += int64(n)
+		if err != nil {
+			return total, err
+		}
+		offset = int(rtn.next)
+	}
+	return total, nil
+}
+
+// stringChunkSize is the size of the buffers WriteStringTo copies through.
+const stringChunkSize = 32 << 10
+
+var stringChunkPool = sync.Pool{
+	New: func() interface{} { return new([stringChunkSize]byte) },
+}
+
+// spareData returns a pointer to the unused capacity of s, or nil if it has
+// none.
+func spareData[T any](s []T) *T {
+	if len(s) == cap(s) {
+		return nil
+	}
+	return &s[:cap(s)][len(s)]
+}
+
+// spareLen returns the unused capacity of s, capped to what a C int holds.
+// Strings V8 can create are much shorter, so the cap never truncates a write.
+func spareLen[T any](s []T) C.int {
+	n := cap(s) - len(s)
+	if n > math.MaxInt32 {
+		n = math.MaxInt32
+	}
+	return C.int(n)
+}
+
+// growSlice returns s with room for at least n more elements.
+func growSlice[T any](s []T, n int) []T {
+	grown := make([]T, len(s), len(s)+n)
+	copy(grown, s)
+	return grown
 }
 
 // Uint32 perform the equivalent of `Number(value)` in JS and convert the result to an
 // unsigned 32-bit integer by performing the steps in https://tc39.es/ecma262/#sec-touint32.
 func (v *Value) Uint32() uint32 {
-	return uint32(C.ValueToUint32(v.ptr))
+	rtn := uint32(C.ValueToUint32(v.ptr))
+	runtime.KeepAlive(v)
+	return rtn
 }
 
 // SameValue returns true if the other value is the same value.
 // This is equivalent to `Object.is(v, other)` in JS.
 func (v *Value) SameValue(other *Value) bool {
-	return C.ValueSameValue(v.ptr, other.ptr) != 0
+	rtn := C.ValueSameValue(v.ptr, other.ptr) != 0
+	runtime.KeepAlive(v)
+	runtime.KeepAlive(other)
+	return rtn
+}
+
+// hasKind reports whether any of the given ValueKind bits are set. The kinds
+// are cached in the value's header when it is created, so this is a plain
+// memory read rather than a cgo call.
+func (v *Value) hasKind(kinds C.uint32_t) bool {
+	rtn := (*C.ValueHeader)(unsafe.Pointer(v.ptr)).kinds&kinds != 0
+	runtime.KeepAlive(v)
+	return rtn
 }
 
 // IsUndefined returns true if this value is the undefined value. See ECMA-262 4.3.10.
 func (v *Value) IsUndefined() bool {
-	return C.ValueIsUndefined(v.ptr) != 0
+	return v.hasKind(C.VALUE_KIND_UNDEFINED)
 }
 
 // IsNull returns true if this value is the null value. See ECMA-262 4.3.11.
 func (v *Value) IsNull() bool {
-	return C.ValueIsNull(v.ptr) != 0
+	return v.hasKind(C.VALUE_KIND_NULL)
 }
 
 // IsNullOrUndefined returns true if this value is either the null or the undefined value.
 // See ECMA-262 4.3.11. and 4.3.12
 // This is equivalent to `value == null` in JS.
 func (v *Value) IsNullOrUndefined() bool {
-	return C.ValueIsNullOrUndefined(v.ptr) != 0
+	return v.hasKind(C.VALUE_KIND_NULL | C.VALUE_KIND_UNDEFINED)
 }
 
 // IsTrue returns true if this value is true.
 // This is not the same as `BooleanValue()`. The latter performs a conversion to boolean,
 // i.e. the result of `Boolean(value)` in JS, whereas this checks `value === true`.
 func (v *Value) IsTrue() bool {
-	return C.ValueIsTrue(v.ptr) != 0
+	return v.hasKind(C.VALUE_KIND_TRUE)
 }
 
 // IsFalse returns true if this value is false.
 // This is not the same as `!BooleanValue()`. The latter performs a conversion to boolean,
 // i.e. the result of `!Boolean(value)` in JS, whereas this checks `value === false`.
 func (v *Value) IsFalse() bool {
-	return C.ValueIsFalse(v.ptr) != 0
+	return v.hasKind(C.VALUE_KIND_FALSE)
 }
 
 // IsName returns true if this value is a symbol or a string.
 // This is equivalent to `typeof value === 'string' || typeof value === 'symbol'` in JS.
 func (v *Value) IsName() bool {
-	return C.ValueIsName(v.ptr) != 0
+	return v.hasKind(C.VALUE_KIND_STRING | C.VALUE_KIND_SYMBOL)
 }
 
 // IsString returns true if this value is an instance of the String type. See ECMA-262 8.4.
 // This is equivalent to `typeof value === 'string'` in JS.
 func (v *Value) IsString() bool {
-	return C.ValueIsString(v.ptr) != 0
+	return v.hasKind(C.VALUE_KIND_STRING)
 }
 
 // IsSymbol returns true if this value is a symbol.
 // This is equivalent to `typeof value === 'symbol'` in JS.
 func (v *Value) IsSymbol() bool {
-	return C.ValueIsSymbol(v.ptr) != 0
+	return v.hasKind(C.VALUE_KIND_SYMBOL)
 }
 
 // IsFunction returns true if this value is a function.
 // This is equivalent to `typeof value === 'function'` in JS.
 func (v *Value) IsFunction() bool {
-	return C.ValueIsFunction(v.ptr) != 0
+	return v.hasKind(C.VALUE_KIND_FUNCTION)
 }
 
 // IsObject returns true if this value is an object.
 func (v *Value) IsObject() bool {
-	return v.ctx != nil && C.ValueIsObject(v.ptr) != 0
+	return v.ctx != nil && v.hasKind(C.VALUE_KIND_OBJECT)
 }
 
 // IsBigInt returns true if this value is a bigint.
 // This is equivalent to `typeof value === 'bigint'` in JS.
 func (v *Value) IsBigInt() bool {
-	return C.ValueIsBigInt(v.ptr) != 0
+	return v.hasKind(C.VALUE_KIND_BIGINT)
 }
 
 // IsBoolean returns true if this value is boolean.
 // This is equivalent to `typeof value === 'boolean'` in JS.
 func (v *Value) IsBoolean() bool {
-	return C.ValueIsBoolean(v.ptr) != 0
+	return v.hasKind(C.VALUE_KIND_TRUE | C.VALUE_KIND_FALSE)
 }
 
 // IsNumber returns true if this value is a number.
 // This is equivalent to `typeof value === 'number'` in JS.
 func (v *Value) IsNumber() bool {
-	return C.ValueIsNumber(v.ptr) != 0
+	return v.hasKind(C.VALUE_KIND_NUMBER)
 }
 
 // IsExternal returns true if this value is an `External` object.
@@ -343,210 +517,280 @@ func (v *Value) IsExternal() bool {
 
 // IsInt32 returns true if this value is a 32-bit signed integer.
 func (v *Value) IsInt32() bool {
-	return C.ValueIsInt32(v.ptr) != 0
+	return v.hasKind(C.VALUE_KIND_INT32)
 }
 
 // IsUint32 returns true if this value is a 32-bit unsigned integer.
 func (v *Value) IsUint32() bool {
-	return C.ValueIsUint32(v.ptr) != 0
+	return v.hasKind(C.VALUE_KIND_UINT32)
 }
 
 // IsDate returns true if this value is a `Date`.
 func (v *Value) IsDate() bool {
-	return C.ValueIsDate(v.ptr) != 0
+	return v.hasKind(C.VALUE_KIND_DATE)
 }
 
 // IsArgumentsObject returns true if this value is an Arguments object.
 func (v *Value) IsArgumentsObject() bool {
-	return C.ValueIsArgumentsObject(v.ptr) != 0
+	rtn := C.ValueIsArgumentsObject(v.ptr) != 0
+	runtime.KeepAlive(v)
+	return rtn
 }
 
 // IsBigIntObject returns true if this value is a BigInt object.
 func (v *Value) IsBigIntObject() bool {
-	return C.ValueIsBigIntObject(v.ptr) != 0
+	rtn := C.ValueIsBigIntObject(v.ptr) != 0
+	runtime.KeepAlive(v)
+	return rtn
 }
 
 // IsNumberObject returns true if this value is a `Number` object.
 func (v *Value) IsNumberObject() bool {
-	return C.ValueIsNumberObject(v.ptr) != 0
+	rtn := C.ValueIsNumberObject(v.ptr) != 0
+	runtime.KeepAlive(v)
+	return rtn
 }
 
 // IsStringObject returns true if this value is a `String` object.
 func (v *Value) IsStringObject() bool {
-	return C.ValueIsStringObject(v.ptr) != 0
+	rtn := C.ValueIsStringObject(v.ptr) != 0
+	runtime.KeepAlive(v)
+	return rtn
 }
 
 // IsSymbolObject returns true if this value is a `Symbol` object.
 func (v *Value) IsSymbolObject() bool {
-	return C.ValueIsSymbolObject(v.ptr) != 0
+	rtn := C.ValueIsSymbolObject(v.ptr) != 0
+	runtime.KeepAlive(v)
+	return rtn
 }
 
 // IsNativeError returns true if this value is a NativeError.
 func (v *Value) IsNativeError() bool {
-	return C.ValueIsNativeError(v.ptr) != 0
+	return v.hasKind(C.VALUE_KIND_NATIVE_ERROR)
 }
 
 // IsRegExp returns true if this value is a `RegExp`.
 func (v *Value) IsRegExp() bool {
-	return C.ValueIsRegExp(v.ptr) != 0
+	return v.hasKind(C.VALUE_KIND_REGEXP)
 }
 
 // IsAsyncFunc returns true if this value is an async function.
 func (v *Value) IsAsyncFunction() bool {
-	return C.ValueIsAsyncFunction(v.ptr) != 0
+	rtn := C.ValueIsAsyncFunction(v.ptr) != 0
+	runtime.KeepAlive(v)
+	return rtn
 }
 
 // Is IsGeneratorFunc returns true if this value is a Generator function.
 func (v *Value) IsGeneratorFunction() bool {
-	return C.ValueIsGeneratorFunction(v.ptr) != 0
+	rtn := C.ValueIsGeneratorFunction(v.ptr) != 0
+	runtime.KeepAlive(v)
+	return rtn
 }
 
 // IsGeneratorObject returns true if this value is a Generator object (iterator).
 func (v *Value) IsGeneratorObject() bool {
-	return C.ValueIsGeneratorObject(v.ptr) != 0
+	rtn := C.ValueIsGeneratorObject(v.ptr) != 0
+	runtime.KeepAlive(v)
+	return rtn
 }
 
 // IsPromise returns true if this value is a `Promise`.
 func (v *Value) IsPromise() bool {
-	return C.ValueIsPromise(v.ptr) != 0
+	return v.hasKind(C.VALUE_KIND_PROMISE)
 }
 
 // IsMap returns true if this value is a `Map`.
 func (v *Value) IsMap() bool {
-	return C.ValueIsMap(v.ptr) != 0
+	return v.hasKind(C.VALUE_KIND_MAP)
 }
 
 // IsSet returns true if this value is a `Set`.
 func (v *Value) IsSet() bool {
-	return C.ValueIsSet(v.ptr) != 0
+	return v.hasKind(C.VALUE_KIND_SET)
 }
 
 // IsMapIterator returns true if this value is a `Map` Iterator.
 func (v *Value) IsMapIterator() bool {
-	return C.ValueIsMapIterator(v.ptr) != 0
+	rtn := C.ValueIsMapIterator(v.ptr) != 0
+	runtime.KeepAlive(v)
+	return rtn
 }
 
 // IsSetIterator returns true if this value is a `Set` Iterator.
 func (v *Value) IsSetIterator() bool {
-	return C.ValueIsSetIterator(v.ptr) != 0
+	rtn := C.ValueIsSetIterator(v.ptr) != 0
+	runtime.KeepAlive(v)
+	return rtn
 }
 
 // IsWeakMap returns true if this value is a `WeakMap`.
 func (v *Value) IsWeakMap() bool {
-	return C.ValueIsWeakMap(v.ptr) != 0
+	rtn := C.ValueIsWeakMap(v.ptr) != 0
+	runtime.KeepAlive(v)
+	return rtn
 }
 
 // IsWeakSet returns true if this value is a `WeakSet`.
 func (v *Value) IsWeakSet() bool {
-	return C.ValueIsWeakSet(v.ptr) != 0
+	rtn := C.ValueIsWeakSet(v.ptr) != 0
+	runtime.KeepAlive(v)
+	return rtn
 }
 
 // IsArray returns true if this value is an array.
 // Note that it will return false for a `Proxy` of an array.
 func (v *Value) IsArray() bool {
-	return C.ValueIsArray(v.ptr) != 0
+	return v.hasKind(C.VALUE_KIND_ARRAY)
 }
 
 // IsArrayBuffer returns true if this value is an `ArrayBuffer`.
 func (v *Value) IsArrayBuffer() bool {
-	return C.ValueIsArrayBuffer(v.ptr) != 0
+	return v.hasKind(C.VALUE_KIND_ARRAY_BUFFER)
 }
 
 // IsArrayBufferView returns true if this value is an `ArrayBufferView`.
 func (v *Value) IsArrayBufferView() bool {
-	return C.ValueIsArrayBufferView(v.ptr) != 0
+	return v.hasKind(C.VALUE_KIND_ARRAY_BUFFER_VIEW)
 }
 
 // IsTypedArray returns true if this value is one of TypedArrays.
 func (v *Value) IsTypedArray() bool {
-	return C.ValueIsTypedArray(v.ptr) != 0
+	return v.hasKind(C.VALUE_KIND_TYPED_ARRAY)
 }
 
 // IsUint8Array returns true if this value is an `Uint8Array`.
 func (v *Value) IsUint8Array() bool {
-	return C.ValueIsUint8Array(v.ptr) != 0
+	rtn := C.ValueIsUint8Array(v.ptr) != 0
+	runtime.KeepAlive(v)
+	return rtn
 }
 
 // IsUint8ClampedArray returns true if this value is an `Uint8ClampedArray`.
 func (v *Value) IsUint8ClampedArray() bool {
-	return C.ValueIsUint8ClampedArray(v.ptr) != 0
+	rtn := C.ValueIsUint8ClampedArray(v.ptr) != 0
+	runtime.KeepAlive(v)
+	return rtn
 }
 
 // IsInt8Array returns true if this value is an `Int8Array`.
 func (v *Value) IsInt8Array() bool {
-	return C.ValueIsInt8Array(v.ptr) != 0
+	rtn := C.ValueIsInt8Array(v.ptr) != 0
+	runtime.KeepAlive(v)
+	return rtn
 }
 
 // IsUint16Array returns true if this value is an `Uint16Array`.
 func (v *Value) IsUint16Array() bool {
-	return C.ValueIsUint16Array(v.ptr) != 0
+	rtn := C.ValueIsUint16Array(v.ptr) != 0
+	runtime.KeepAlive(v)
+	return rtn
 }
 
 // IsInt16Array returns true if this value is an `Int16Array`.
 func (v *Value) IsInt16Array() bool {
-	return C.ValueIsInt16Array(v.ptr) != 0
+	rtn := C.ValueIsInt16Array(v.ptr) != 0
+	runtime.KeepAlive(v)
+	return rtn
 }
 
 // IsUint32Array returns true if this value is an `Uint32Array`.
 func (v *Value) IsUint32Array() bool {
-	return C.ValueIsUint32Array(v.ptr) != 0
+	rtn := C.ValueIsUint32Array(v.ptr) != 0
+	runtime.KeepAlive(v)
+	return rtn
 }
 
 // IsInt32Array returns true if this value is an `Int32Array`.
 func (v *Value) IsInt32Array() bool {
-	return C.ValueIsInt32Array(v.ptr) != 0
+	rtn := C.ValueIsInt32Array(v.ptr) != 0
+	runtime.KeepAlive(v)
+	return rtn
 }
 
 // IsFloat32Array returns true if this value is a `Float32Array`.
 func (v *Value) IsFloat32Array() bool {
-	return C.ValueIsFloat32Array(v.ptr) != 0
+	rtn := C.ValueIsFloat32Array(v.ptr) != 0
+	runtime.KeepAlive(v)
+	return rtn
 }
 
 // IsFloat64Array returns true if this value is a `Float64Array`.
 func (v *Value) IsFloat64Array() bool {
-	return C.ValueIsFloat64Array(v.ptr) != 0
+	rtn := C.ValueIsFloat64Array(v.ptr) != 0
+	runtime.KeepAlive(v)
+	return rtn
 }
 
 // IsBigInt64Array returns true if this value is a `BigInt64Array`.
 func (v *Value) IsBigInt64Array() bool {
-	return C.ValueIsBigInt64Array(v.ptr) != 0
+	rtn := C.ValueIsBigInt64Array(v.ptr) != 0
+	runtime.KeepAlive(v)
+	return rtn
 }
 
 // IsBigUint64Array returns true if this value is a BigUint64Array`.
 func (v *Value) IsBigUint64Array() bool {
-	return C.ValueIsBigUint64Array(v.ptr) != 0
+	rtn := C.ValueIsBigUint64Array(v.ptr) != 0
+	runtime.KeepAlive(v)
+	return rtn
 }
 
 // IsDataView returns true if this value is a `DataView`.
 func (v *Value) IsDataView() bool {
-	return C.ValueIsDataView(v.ptr) != 0
+	rtn := C.ValueIsDataView(v.ptr) != 0
+	runtime.KeepAlive(v)
+	return rtn
 }
 
 // IsSharedArrayBuffer returns true if this value is a `SharedArrayBuffer`.
 func (v *Value) IsSharedArrayBuffer() bool {
-	return C.ValueIsSharedArrayBuffer(v.ptr) != 0
+	return v.hasKind(C.VALUE_KIND_SHARED_ARRAY_BUFFER)
 }
 
 // IsProxy returns true if this value is a JavaScript `Proxy`.
 func (v *Value) IsProxy() bool {
-	return C.ValueIsProxy(v.ptr) != 0
+	return v.hasKind(C.VALUE_KIND_PROXY)
 }
 
 // Release this value.  Using the value after calling this function will result in undefined behavior.
 func (v *Value) Release() {
+	v.clearReleaseFinalizer()
 	C.ValueRelease(v.ptr)
 }
 
+// ReleaseAll releases all the given values in a single call into V8. Nil
+// entries are skipped. All values must belong to the same isolate. Using any
+// of the values after calling this function will result in undefined behavior.
+func ReleaseAll(vals []*Value) {
+	ptrs := make([]C.ValuePtr, 0, len(vals))
+	for _, v := range vals {
+		if v != nil {
+			v.clearReleaseFinalizer()
+			ptrs = append(ptrs, v.ptr)
+		}
+	}
+	if len(ptrs) == 0 {
+		return
+	}
+	C.ValueReleaseMany(&ptrs[0], C.int(len(ptrs)))
+}
+
 // IsWasmModuleObject returns true if this value is a `WasmModuleObject`.
 func (v *Value) IsWasmModuleObject() bool {
 	// TODO(rogchap): requires test case
-	return C.ValueIsWasmModuleObject(v.ptr) != 0
+	rtn := C.ValueIsWasmModuleObject(v.ptr) != 0
+	runtime.KeepAlive(v)
+	return rtn
 }
 
 // IsModuleNamespaceObject returns true if the value is a `Module` Namespace `Object`.
 func (v *Value) IsModuleNamespaceObject() bool {
 	// TODO(rogchap): requires test case
-	return C.ValueIsModuleNamespaceObject(v.ptr) != 0
+	rtn := C.ValueIsModuleNamespaceObject(v.ptr) != 0
+	runtime.KeepAlive(v)
+	return rtn
 }
 
 // AsObject will cast the value to the Object type. If the value is not an Object
@@ -604,6 +848,7 @@ func (v *Value) SharedArrayBufferGetContents() ([]byte, func(), error) {
 	}
 
 	backingStore := C.SharedArrayBufferGetBackingStore(v.ptr)
+	runtime.KeepAlive(v)
 	release := func() {
 		C.BackingStoreRelease(backingStore)
 	}
@@ -616,11 +861,26 @@ func (v *Value) SharedArrayBufferGetContents() ([]byte, func(), error) {
 }
 
 func (v *Value) StrictEquals(other *Value) bool {
-	return C.ValueStrictEquals(v.ptr, other.ptr) != 0
+	rtn := C.ValueStrictEquals(v.ptr, other.ptr) != 0
+	runtime.KeepAlive(v)
+	runtime.KeepAlive(other)
+	return rtn
 }
 
 func (v *Value) TypeOf() string {
 	s := C.ValueTypeOf(v.ptr)
+	runtime.KeepAlive(v)
 	defer C.RtnStringRelease(s)
 	return C.GoStringN(s.data, C.int(s.length))
 }
+
+// cStringN returns the bytes of s and their count, for C functions taking a
+// pointer and a length. The bytes are read in place, so C must neither modify
+// nor retain them. It panics if s is too long for a C int, since V8 would take
+// the wrapped, negative length to mean a NUL-terminated string.
+func cStringN(s string) (*C.char, C.int) {
+	if len(s) > math.MaxInt32 {
+		panic(fmt.Sprintf("v8go: string of %d bytes is too long", len(s)))
+	}
+	return (*C.char)(unsafe.Pointer(stringData(s))), C.int(len(s))
+}
@@ -6,6 +6,43 @@
 
 #include "errors.h"
 
+// Bits of ValueHeader.kinds. Each bit caches the result of the corresponding
+// v8::Value::Is* predicate, computed once when the value is tracked.
+typedef enum {
+  VALUE_KIND_UNDEFINED = 1 << 0,
+  VALUE_KIND_NULL = 1 << 1,
+  VALUE_KIND_TRUE = 1 << 2,
+  VALUE_KIND_FALSE = 1 << 3,
+  VALUE_KIND_STRING = 1 << 4,
+  VALUE_KIND_SYMBOL = 1 << 5,
+  VALUE_KIND_NUMBER = 1 << 6,
+  VALUE_KIND_INT32 = 1 << 7,
+  VALUE_KIND_UINT32 = 1 << 8,
+  VALUE_KIND_BIGINT = 1 << 9,
+  VALUE_KIND_OBJECT = 1 << 10,
+  VALUE_KIND_FUNCTION = 1 << 11,
+  VALUE_KIND_PROXY = 1 << 12,
+  VALUE_KIND_ARRAY = 1 << 13,
+  VALUE_KIND_PROMISE = 1 << 14,
+  VALUE_KIND_NATIVE_ERROR = 1 << 15,
+  VALUE_KIND_DATE = 1 << 16,
+  VALUE_KIND_REGEXP = 1 << 17,
+  VALUE_KIND_MAP = 1 << 18,
+  VALUE_KIND_SET = 1 << 19,
+  VALUE_KIND_ARRAY_BUFFER = 1 << 20,
+  VALUE_KIND_SHARED_ARRAY_BUFFER = 1 << 21,
+  VALUE_KIND_ARRAY_BUFFER_VIEW = 1 << 22,
+  VALUE_KIND_TYPED_ARRAY = 1 << 23,
+} ValueKind;
+
+// ValueHeader is the first member of every m_value. Go reads it directly
+// through the ValuePtr, so type checks don't need a cgo call.
+typedef struct {
+  // The id of the value in its context's value table.
+  long id;
+  uint32_t kinds;
+} ValueHeader;
+
 #ifdef __cplusplus
 
 #include "deps/include/v8-persistent-handle.h"
@@ -18,14 +55,20 @@ class Value;
 typedef struct m_ctx m_ctx;
 
 struct m_value {
-  long id;
+  // Must stay the first member; see ValueHeader.
+  ValueHeader header;
   v8::Isolate* iso;
   m_ctx* ctx;
   v8::Global<v8::Value> ptr;
+  // The depth of the value scope that releases this value, or zero if it is
+  // only released explicitly or with its context.
+  int scope;
 };
 
 typedef v8::Isolate v8Isolate;
 
+extern uint32_t value_kinds(v8::Local<v8::Value> value);
+
 extern "C" {
 #else
 
@@ -52,9 +95,31 @@ typedef struct {
   RtnError error;
 } RtnString;
 
+typedef struct {
+  // The number of bytes written.
+  int length;
+  // The UTF-16 offset to continue from, or -1 at the end of the string.
+  int next;
+} RtnStringChunk;
+
 void ValueRelease(ValuePtr ptr);
+void ValueReleaseMany(ValuePtr* ptrs, int len);
+void ValueEscape(ValuePtr ptr, int depth);
 void RtnStringRelease(RtnString rtnString);
 extern RtnString ValueToString(ValuePtr ptr);
+// ValueWrite* convert the value to a string and write it to buf if it fits in
+// cap code units. They return the length of the string in code units either
+// way, or -1 if the string can't be represented as Latin-1.
+extern int ValueWriteUtf8(ValuePtr ptr, char* buf, int cap);
+extern int ValueWriteUtf16(ValuePtr ptr, uint16_t* buf, int cap);
+extern int ValueWriteLatin1(ValuePtr ptr, uint8_t* buf, int cap);
+// ValueWriteUtf8Chunk converts the value to a string and writes as much of it
+// as fits in cap bytes, starting at the UTF-16 offset, as UTF-8. cap must be at
+// least 6.
+extern RtnStringChunk ValueWriteUtf8Chunk(ValuePtr ptr,
+                                          int offset,
+                                          char* buf,
+                                          int cap);
 extern RtnString ValueTypeOf(ValuePtr ptr);
 const uint32_t* ValueToArrayIndex(ValuePtr ptr);
 int ValueToBoolean(ValuePtr ptr);
@@ -66,44 +131,19 @@ uint32_t ValueToUint32(ValuePtr ptr);
 extern ValueBigInt ValueToBigInt(ValuePtr ptr);
 extern RtnValue ValueToObject(ValuePtr ptr);
 int ValueSameValue(ValuePtr ptr, ValuePtr otherPtr);
-int ValueIsUndefined(ValuePtr ptr);
-int ValueIsNull(ValuePtr ptr);
-int ValueIsNullOrUndefined(ValuePtr ptr);
-int ValueIsTrue(ValuePtr ptr);
-int ValueIsFalse(ValuePtr ptr);
-int ValueIsName(ValuePtr ptr);
-int ValueIsString(ValuePtr ptr);
-int ValueIsSymbol(ValuePtr ptr);
-int ValueIsFunction(ValuePtr ptr);
-int ValueIsObject(ValuePtr ptr);
-int ValueIsBigInt(ValuePtr ptr);
-int ValueIsBoolean(ValuePtr ptr);
-int ValueIsNumber(ValuePtr ptr);
 int ValueIsExternal(ValuePtr ptr);
-int ValueIsInt32(ValuePtr ptr);
-int ValueIsUint32(ValuePtr ptr);
-int ValueIsDate(ValuePtr ptr);
 int ValueIsArgumentsObject(ValuePtr ptr);
 int ValueIsBigIntObject(ValuePtr ptr);
 int ValueIsNumberObject(ValuePtr ptr);
 int ValueIsStringObject(ValuePtr ptr);
 int ValueIsSymbolObject(ValuePtr ptr);
-int ValueIsNativeError(ValuePtr ptr);
-int ValueIsRegExp(ValuePtr ptr);
 int ValueIsAsyncFunction(ValuePtr ptr);
 int ValueIsGeneratorFunction(ValuePtr ptr);
 int ValueIsGeneratorObject(ValuePtr ptr);
-int ValueIsPromise(ValuePtr ptr);
-int ValueIsMap(ValuePtr ptr);
-int ValueIsSet(ValuePtr ptr);
 int ValueIsMapIterator(ValuePtr ptr);
 int ValueIsSetIterator(ValuePtr ptr);
 int ValueIsWeakMap(ValuePtr ptr);
 int ValueIsWeakSet(ValuePtr ptr);
-int ValueIsArray(ValuePtr ptr);
-int ValueIsArrayBuffer(ValuePtr ptr);
-int ValueIsArrayBufferView(ValuePtr ptr);
-int ValueIsTypedArray(ValuePtr ptr);
 int ValueIsUint8Array(ValuePtr ptr);
 int ValueIsUint8ClampedArray(ValuePtr ptr);
 int ValueIsInt8Array(ValuePtr ptr);
@@ -116,8 +156,6 @@ int ValueIsFloat64Array(ValuePtr ptr);
 int ValueIsBigInt64Array(ValuePtr ptr);
 int ValueIsBigUint64Array(ValuePtr ptr);
 int ValueIsDataView(ValuePtr ptr);
-int ValueIsSharedArrayBuffer(ValuePtr ptr);
-int ValueIsProxy(ValuePtr ptr);
 int ValueIsWasmModuleObject(ValuePtr ptr);
 int ValueIsModuleNamespaceObject(ValuePtr ptr);
 int ValueStrictEquals(ValuePtr ptr, ValuePtr otherPtr);
@@ -137,23 +175,27 @@ extern RtnValue NewValueBigIntFromWords(IsolatePtr iso_ptr,
                                         const uint64_t* words);
 extern ValuePtr NewValueError(IsolatePtr iso_ptr,
                               ErrorTypeIndex idx,
-                              const char* message);
+                              const char* message,
+                              int message_len);
 
 const char* ExceptionGetMessageString(ValuePtr ptr);
 
-extern void ObjectSet(ValuePtr ptr, const char* key, ValuePtr val_ptr);
+extern void ObjectSet(ValuePtr ptr,
+                      const char* key,
+                      int key_len,
+                      ValuePtr val_ptr);
 extern void ObjectSetAnyKey(ValuePtr ptr, ValuePtr key, ValuePtr val_ptr);
 extern void ObjectSetIdx(ValuePtr ptr, uint32_t idx, ValuePtr val_ptr);
 extern int ObjectSetInternalField(ValuePtr ptr, int idx, ValuePtr val_ptr);
 extern int ObjectInternalFieldCount(ValuePtr ptr);
-extern RtnValue ObjectGet(ValuePtr ptr, const char* key);
+extern RtnValue ObjectGet(ValuePtr ptr, const char* key, int key_len);
 extern RtnValue ObjectGetAnyKey(ValuePtr ptr, ValuePtr key);
 extern RtnValue ObjectGetIdx(ValuePtr ptr, uint32_t idx);
 extern RtnValue ObjectGetInternalField(ValuePtr ptr, int idx);
-int ObjectHas(ValuePtr ptr, const char* key);
+int ObjectHas(ValuePtr ptr, const char* key, int key_len);
 int ObjectHasAnyKey(ValuePtr ptr, ValuePtr key);
 int ObjectHasIdx(ValuePtr ptr, uint32_t idx);
-int ObjectDelete(ValuePtr ptr, const char* key);
+int ObjectDelete(ValuePtr ptr, const char* key, int key_len);
 int ObjectDeleteAnyKey(ValuePtr ptr, ValuePtr key);
 int ObjectDeleteIdx(ValuePtr ptr, uint32_t idx);
 extern RtnValue ObjectGetPrototype(ValuePtr ptr);
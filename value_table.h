@@ -0,0 +1,98 @@
+#ifndef V8GO_VALUE_TABLE_H
+#define V8GO_VALUE_TABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+typedef struct m_value m_value;
+
+// m_valueTable is the registry of values tracked by a context. Values live in
+// a dense slot vector, with released slots chained into a free list. A value's
+// id encodes both its slot index and the generation of that slot, so tracking,
+// lookup and release are plain array operations, and an id that outlived its
+// value never resolves to whatever reused the slot.
+//
+// m_valueTable is not thread-safe; callers are expected to hold the isolate
+// lock.
+class m_valueTable {
+ public:
+  static_assert(sizeof(long) == 8, "value ids need 64-bit longs");
+
+  // Track registers val and returns its id, which is never zero.
+  long Track(m_value* val) {
+    uint32_t index;
+    if (free_ != kNoSlot) {
+      index = free_;
+      free_ = slots_[index].next_free;
+    } else {
+      index = static_cast<uint32_t>(slots_.size());
+      slots_.push_back(slot{nullptr, 1, kNoSlot});
+    }
+    slot& s = slots_[index];
+    s.val = val;
+    ++count_;
+    return (static_cast<long>(s.generation) << 32) | index;
+  }
+
+  // Get returns the value with the given id, or nullptr if it has been
+  // released.
+  m_value* Get(long id) const {
+    uint32_t index = static_cast<uint32_t>(id);
+    if (index >= slots_.size()) {
+      return nullptr;
+    }
+    const slot& s = slots_[index];
+    if (s.generation != static_cast<uint32_t>(id >> 32)) {
+      return nullptr;
+    }
+    return s.val;
+  }
+
+  // Untrack releases the slot of the value with the given id. It returns
+  // false, and does nothing, if the id is stale.
+  bool Untrack(long id) {
+    if (Get(id) == nullptr) {
+      return false;
+    }
+    uint32_t index = static_cast<uint32_t>(id);
+    slot& s = slots_[index];
+    s.val = nullptr;
+    // Generation 0 is skipped so that no id is ever zero.
+    if (++s.generation == 0) {
+      s.generation = 1;
+    }
+    s.next_free = free_;
+    free_ = index;
+    --count_;
+    return true;
+  }
+
+  size_t Count() const { return count_; }
+
+  // ForEach calls fn for every tracked value.
+  template <typename F>
+  void ForEach(F fn) const {
+    for (const slot& s : slots_) {
+      if (s.val != nullptr) {
+        fn(s.val);
+      }
+    }
+  }
+
+ private:
+  static constexpr uint32_t kNoSlot = UINT32_MAX;
+
+  struct slot {
+    m_value* val;
+    uint32_t generation;
+    uint32_t next_free;
+  };
+
+  std::vector<slot> slots_;
+  uint32_t free_ = kNoSlot;
+  size_t count_ = 0;
+};
+
+#endif
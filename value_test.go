@@ -11,7 +11,9 @@ import (
 	"math/big"
 	"reflect"
 	"runtime"
+	"strings"
 	"testing"
+	"unicode/utf16"
 
 	v8 "github.com/tommie/v8go"
 )
@@ -84,6 +86,7 @@ func TestValueString(t *testing.T) {
 		{"String with null character and non-latin unicode", `"a\x00Ω"`, "a\x00Ω"},
 		{"Object", `let obj = {}; obj`, "[object Object]"},
 		{"Function", `let fn = function(){}; fn`, "function(){}"},
+		{"Long string", `"é".repeat(100)`, strings.Repeat("é", 100)},
 	}
 
 	for _, tt := range tests {
@@ -98,6 +101,69 @@ func TestValueString(t *testing.T) {
 	}
 }
 
+func TestValueAppendString(t *testing.T) {
+	t.Parallel()
+	ctx := v8.NewContext(nil)
+	defer ctx.Isolate().Dispose()
+	defer ctx.Close()
+
+	latin1, err := ctx.RunScript(`"café"`, "")
+	fatalIf(t, err)
+	wide, err := ctx.RunScript(`"a😀"`, "")
+	fatalIf(t, err)
+	num, err := ctx.RunScript(`42`, "")
+	fatalIf(t, err)
+
+	buf := make([]byte, 0, 3)
+	buf = append(buf, '>')
+	buf = latin1.AppendString(buf)
+	buf = num.AppendString(buf)
+	if s := string(buf); s != ">café42" {
+		t.Errorf("unexpected AppendString result %q", s)
+	}
+
+	if b, ok := latin1.AppendLatin1(nil); !ok || string(b) != "caf\xe9" {
+		t.Errorf("unexpected AppendLatin1 result %q, %v", b, ok)
+	}
+	if b, ok := wide.AppendLatin1([]byte("x")); ok || string(b) != "x" {
+		t.Errorf("expected AppendLatin1 to fail unchanged, got %q, %v", b, ok)
+	}
+
+	if u := wide.AppendUTF16(nil); !reflect.DeepEqual(u, utf16.Encode([]rune("a😀"))) {
+		t.Errorf("unexpected AppendUTF16 result %v", u)
+	}
+	if u := num.AppendUTF16([]uint16{'x'}); string(utf16.Decode(u)) != "x42" {
+		t.Errorf("unexpected AppendUTF16 result %v", u)
+	}
+}
+
+func TestValueWriteStringTo(t *testing.T) {
+	t.Parallel()
+	ctx := v8.NewContext(nil)
+	defer ctx.Isolate().Dispose()
+	defer ctx.Close()
+
+	for _, source := range []string{
+		`""`,
+		`"abc"`,
+		// Surrogate pairs straddle the chunk boundaries.
+		`"x😀é".repeat(30000)`,
+		`"\uD800a\uDC00"`,
+		// Leaves two bytes of the chunk buffer for the last unit.
+		`"€".repeat(10923)`,
+		`[1, 2]`,
+	} {
+		val, err := ctx.RunScript(source, "")
+		fatalIf(t, err)
+		var buf bytes.Buffer
+		n, err := val.WriteStringTo(&buf)
+		fatalIf(t, err)
+		if want := val.String(); n != int64(len(want)) || buf.String() != want {
+			t.Errorf("%s: expected %d bytes matching String, got %d", source, len(want), n)
+		}
+	}
+}
+
 func TestNewValue(t *testing.T) {
 	t.Parallel()
 	ctx := v8.NewContext(nil)
@@ -590,6 +656,32 @@ func TestValueSameValue(t *testing.T) {
 	}
 }
 
+func TestReleaseAll(t *testing.T) {
+	t.Parallel()
+
+	ctx := v8.NewContext()
+	defer ctx.Isolate().Dispose()
+	defer ctx.Close()
+
+	vals := []*v8.Value{nil}
+	for i := 0; i < 10; i++ {
+		val, err := ctx.RunScript("({})", "")
+		fatalIf(t, err)
+		vals = append(vals, val)
+	}
+	keep, err := ctx.RunScript("({})", "")
+	fatalIf(t, err)
+
+	v8.ReleaseAll(vals)
+	v8.ReleaseAll(nil)
+	if n := ctx.RetainedValueCount(); n != 1 {
+		t.Fatalf("expected 1 retained value, got %d", n)
+	}
+	if !keep.IsObject() {
+		t.Errorf("expected the kept value to be unaffected")
+	}
+}
+
 func TestValueIsXXX(t *testing.T) {
 	t.Parallel()
 	iso := v8.NewIsolate()
@@ -688,6 +780,9 @@ func TestValueIsXXX(t *testing.T) {
 		{"new DataView(new ArrayBuffer)", (*v8.Value).IsDataView},
 		{"new SharedArrayBuffer", (*v8.Value).IsSharedArrayBuffer},
 		{"new Proxy({},{})", (*v8.Value).IsProxy},
+		{"new Proxy(() => {},{})", (*v8.Value).IsProxy},
+		{"new Proxy(() => {},{})", (*v8.Value).IsFunction},
+		{"new Proxy([],{})", (*v8.Value).IsObject},
 	}
 	for _, tt := range tests {
 		tt := tt